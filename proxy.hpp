@@ -7,6 +7,8 @@
 #include <eosio/singleton.hpp>
 #include <eosio/transaction.hpp>
 
+#include <array>
+#include <cstring>
 #include <string>
 #include <optional>
 
@@ -23,6 +25,58 @@
 #include <delphioracle/delphioracle.hpp>
 
 static constexpr int64_t DAY = 86400; // 24 hours
+static constexpr uint64_t CLAIMALL_LIMIT = 50; // default `claimall` & `claimref` batch
+static constexpr int64_t SPONSOR_QUOTA = 2; // default daily sponsored actions per owner
+static constexpr int64_t SPONSOR_PRIORITY_QUOTA = 10; // default daily sponsored `claim` & `signup` per owner
+static constexpr size_t MAX_REWARDS = 8; // maximum reward tokens per portfolio & registered in `rewards`
+static constexpr size_t CLAIM_ARENA_SIZE = 8192; // per-voter scratch memory of the claim path
+
+/**
+ * Fixed-capacity list of reward payouts used on the claim path instead of `std::vector<asset>`
+ *
+ * Payouts of the same token are merged, so a list holds the portfolio tokens plus one EOS line for
+ * under-funded tokens redirected to EOS.
+ */
+struct reward_list {
+    std::array<eosio::asset, MAX_REWARDS + 1>   items;
+    size_t                                      count = 0;
+
+    void add( const eosio::asset& quantity ) {
+        for ( size_t i = 0; i < count; ++i ) {
+            if ( items[i].symbol == quantity.symbol ) {
+                items[i] += quantity;
+                return;
+            }
+        }
+        eosio::check( count < items.size(), "proxy::reward_list: exceeds maximum reward tokens" );
+        items[count++] = quantity;
+    }
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const eosio::asset* begin() const { return items.data(); }
+    const eosio::asset* end() const { return items.data() + count; }
+};
+
+/**
+ * Bump arena for the per-voter scratch data of the claim path (raw table rows & packed inline actions)
+ *
+ * The CDT allocator does not reuse freed memory within an action, so heap allocations per voter add up over a
+ * `claimall` batch; arena memory is reused by `reset()` before each voter instead.
+ */
+struct bump_arena {
+    alignas( 8 ) std::array<char, CLAIM_ARENA_SIZE>    buffer;
+    size_t                                              used = 0;
+
+    char* allocate( const size_t size ) {
+        eosio::check( size <= buffer.size() - used, "proxy::bump_arena: claim arena exhausted" );
+        char* data = buffer.data() + used;
+        used += ( size + 7 ) & ~size_t( 7 );
+        if ( used > buffer.size() ) used = buffer.size();
+        return data;
+    }
+    void reset() { used = 0; }
+};
 
 using namespace eosio;
 using namespace std;
@@ -108,7 +162,7 @@ public:
     };
 
     /**
-     * ## TABLE `portfolio`
+     * ## TABLE `portfolio2`
      *
      * - `{name} owner` - owner's portfolio
      * - `{vector<symbol_code>} rewards` - reward token symbols
@@ -172,13 +226,13 @@ public:
     };
 
     /**
-     * ## TABLE `v2.voters`
+     * ## TABLE `voters.v2`
      *
      * - `{name} owner` - owner staking to proxy
      * - `{time_point_sec} next_claim_period` - next available claim period
      * - `{int64_t} staked` - voter info staked
      * - `{name} referral` - referral account
-     * - `{set<symbol_code>} rewards` - (default ["EOS"]) receiving reward token
+     * - `{set<symbol_code>} rewards` - (default ["EOS"]) receiving reward tokens (maximum of 8, from `setportfolio`)
      * - `{map<name, bool>} protocol_features` - (true/false) activated protocol features
      *
      *
@@ -208,6 +262,12 @@ public:
         uint64_t primary_key() const { return owner.value; }
         uint64_t by_next_claim() const { return next_claim_period.sec_since_epoch(); }
         uint64_t by_referral() const { return referral.value; }
+
+        bool operator==( const voters_v2_row& other ) const {
+            return owner == other.owner && next_claim_period == other.next_claim_period && staked == other.staked
+                && referral == other.referral && rewards == other.rewards && protocol_features == other.protocol_features;
+        }
+        bool operator!=( const voters_v2_row& other ) const { return !( *this == other ); }
     };
 
     /**
@@ -310,6 +370,123 @@ public:
         uint64_t primary_key() const { return owner.value; }
     };
 
+    /**
+     * ## TABLE `treasury`
+     *
+     * - `{symbol_code} sym_code` - reward token symbol code
+     * - `{extended_asset} balance` - contract balance of reward token after the last payout or at `syncbalance`
+     * - `{asset} paid` - rewards paid during current payout window
+     * - `{asset} last_paid` - rewards paid during previous 24 hour payout window
+     * - `{time_point_sec} window_start` - start of current 24 hour payout window
+     * - `{int64_t} runway` - seconds until balance is exhausted at the current payout rate (-1 if no payouts)
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "sym_code": "DAPP",
+     *   "balance": {"quantity": "25000.0000 DAPP", "contract": "dappservices"},
+     *   "paid": "1250.0000 DAPP",
+     *   "last_paid": "1250.0000 DAPP",
+     *   "window_start": "2019-08-07T00:00:00",
+     *   "runway": 1728000
+     * }
+     * ```
+     */
+    struct [[eosio::table("treasury")]] treasury_row {
+        symbol_code         sym_code;
+        extended_asset      balance;
+        asset               paid;
+        asset               last_paid;
+        time_point_sec      window_start;
+        int64_t             runway = -1;
+
+        uint64_t primary_key() const { return sym_code.raw(); }
+    };
+
+    /**
+     * ## TABLE `epochs`
+     *
+     * - `{uint64_t} epoch` - distribution epoch
+     * - `{checksum256} root` - merkle root of `sha256(index, owner, amounts)` leaves
+     * - `{vector<extended_asset>} totals` - total rewards of epoch per token, sorted by symbol code
+     * - `{vector<asset>} claimed` - rewards claimed from epoch, same order as `totals`
+     * - `{uint64_t} leaves` - number of leaves in merkle tree
+     * - `{time_point_sec} period` - claim period paid by the epoch (voters due at this time)
+     * - `{time_point_sec} expires` - after which unclaimed rewards return to the treasury
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "epoch": 1,
+     *   "root": "5a3d8d0b0cb8c4d5e0d5cfc3c8f8e2bf9d1f6d0c0b1a2e3f4a5b6c7d8e9f0a1b",
+     *   "totals": [{"quantity": "12500.0000 EOS", "contract": "eosio.token"}, {"quantity": "2500000.0000 DAPP", "contract": "dappservices"}],
+     *   "claimed": ["310.2041 EOS", "41250.1200 DAPP"],
+     *   "leaves": 250000,
+     *   "period": "2019-08-07T00:00:00",
+     *   "expires": "2019-09-07T00:00:00"
+     * }
+     * ```
+     */
+    struct [[eosio::table("epochs")]] epochs_row {
+        uint64_t            epoch;
+        checksum256                 root;
+        std::vector<extended_asset> totals;
+        std::vector<asset>          claimed;
+        uint64_t            leaves;
+        time_point_sec      period;
+        time_point_sec      expires;
+
+        uint64_t primary_key() const { return epoch; }
+    };
+
+    /**
+     * ## TABLE `claimed`
+     *
+     * - Scope: `epoch`
+     *
+     * - `{uint64_t} word` - bitmap word (leaf index / 64)
+     * - `{uint64_t} bits` - claimed bits of leaves in word
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "word": 3,
+     *   "bits": 9
+     * }
+     * ```
+     */
+    struct [[eosio::table("claimed")]] claimed_row {
+        uint64_t            word;
+        uint64_t            bits = 0;
+
+        uint64_t primary_key() const { return word; }
+    };
+
+    /**
+     * ## TABLE `cursors`
+     *
+     * - `{name} referral` - referral account
+     * - `{name} owner` - last owner claimed by `claimref`
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "referral": "tokenyieldio",
+     *   "owner": "myaccount"
+     * }
+     * ```
+     */
+    struct [[eosio::table("cursors")]] cursors_row {
+        name            referral;
+        name            owner;
+
+        uint64_t primary_key() const { return referral.value; }
+    };
+
     /**
      * ## TABLE `settings`
      *
@@ -317,6 +494,9 @@ public:
      * - `{int64_t} [referral_rate=500]` - referral rate pips 1/100 of 1% (maximum of 5%)
      * - `{int64_t} [interval=86400]` - claim interval in seconds
      * - `{bool} [paused=false]` - true/false if contract is paused for maintenance
+     * - `{int64_t} [sponsor_quota=2]` - daily CPU sponsored actions per owner
+     * - `{int64_t} [sponsor_priority_quota=10]` - daily CPU sponsored `claim` & `signup` actions per owner
+     * - `{name} [publisher=""]` - account authorized to publish merkle `epochs`
      *
      * ### example
      *
@@ -325,7 +505,10 @@ public:
      *   "rate": 185,
      *   "referral_rate": 500,
      *   "interval": 86400,
-     *   "paused": false
+     *   "paused": false,
+     *   "sponsor_quota": 2,
+     *   "sponsor_priority_quota": 10,
+     *   "publisher": "eosnationftw"
      * }
      * ```
      */
@@ -334,6 +517,66 @@ public:
         int64_t referral_rate = 500;
         int64_t interval = 86400;
         bool paused = false;
+        binary_extension<int64_t> sponsor_quota = SPONSOR_QUOTA;
+        binary_extension<int64_t> sponsor_priority_quota = SPONSOR_PRIORITY_QUOTA;
+        binary_extension<name> publisher = name{};
+    };
+
+    /**
+     * ## TABLE `sponsored`
+     *
+     * - `{name} owner` - owner receiving CPU sponsorship
+     * - `{time_point_sec} day_start` - start of current 24 hour quota period
+     * - `{int64_t} count` - sponsored actions during current quota period
+     * - `{int64_t} priority_count` - sponsored `claim` & `signup` actions during current quota period
+     * - `{int64_t} total` - total sponsored actions since `day_start` rows were last pruned
+     *
+     * > Rows idle for over 24 hours are pruned by `payforcpu` (oldest first) and `prunesponsor`
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "owner": "myaccount",
+     *   "day_start": "2019-08-07T00:00:00",
+     *   "count": 0,
+     *   "priority_count": 1,
+     *   "total": 42
+     * }
+     * ```
+     */
+    struct [[eosio::table("sponsored")]] sponsored_row {
+        name                owner;
+        time_point_sec      day_start;
+        int64_t             count = 0;
+        int64_t             priority_count = 0;
+        int64_t             total = 0;
+
+        uint64_t primary_key() const { return owner.value; }
+        uint64_t by_day_start() const { return day_start.sec_since_epoch(); }
+    };
+
+    /**
+     * ## TABLE `sponsorship`
+     *
+     * - `{int64_t} total` - total sponsored actions
+     * - `{int64_t} claims` - total sponsored `claim` actions
+     * - `{int64_t} signups` - total sponsored `signup` actions
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "total": 10250,
+     *   "claims": 9800,
+     *   "signups": 312
+     * }
+     * ```
+     */
+    struct [[eosio::table("sponsorship")]] sponsorship_row {
+        int64_t total = 0;
+        int64_t claims = 0;
+        int64_t signups = 0;
     };
 
     /**
@@ -352,6 +595,11 @@ public:
             _proxies( get_self(), get_self().value ),
             _staked( get_self(), get_self().value ),
             _portfolio2( get_self(), get_self().value ),
+            _treasury( get_self(), get_self().value ),
+            _cursors( get_self(), get_self().value ),
+            _sponsored( get_self(), get_self().value ),
+            _sponsorship( get_self(), get_self().value ),
+            _epochs( get_self(), get_self().value ),
             _eosio_voters( "eosio"_n, "eosio"_n.value ),
             _rexpool( "eosio"_n, "eosio"_n.value )
     {}
@@ -484,6 +732,7 @@ public:
      * Set authorized reward asset
      *
      * - Authority: `get_self()`
+     * - Maximum of 8 registered reward tokens (`MAX_REWARDS`)
      *
      * ### params
      *
@@ -526,6 +775,7 @@ public:
      * Set owner's portfolio reward allocation
      *
      * - Authority: `owner` or `get_self()`
+     * - Maximum of 8 reward tokens (`MAX_REWARDS`), percentages must add up to 100% (10000)
      *
      * ### params
      *
@@ -730,9 +980,208 @@ public:
     [[eosio::action]]
     void receipt( const name owner, const asset staked, const std::vector<asset> rewards );
 
+    /**
+     * ## ACTION `claimall`
+     *
+     * Claim rewards from all voters whose `next_claim_period` has passed
+     *
+     * > Walks the `bynextclaim` index from the oldest due voter and stops at the first voter not yet due,
+     * > so cranks can push fixed-size transactions without underfilling or re-reading the table
+     *
+     * Same eligibility & referral steps as `claim`, except that voters of an inactive proxy move to the next period
+     * unpaid instead of failing the batch.
+     *
+     * - Authority: `get_self()`
+     *
+     * ### params
+     *
+     * - `{uint64_t} [limit=50]` - (optional) maximum number of voters to claim in this transaction
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation claimall '[]' -p proxy4nation
+     * cleos push action proxy4nation claimall '[200]' -p proxy4nation
+     * ```
+     */
+    [[eosio::action]]
+    void claimall( const binary_extension<uint64_t> limit );
+
+    /**
+     * ## ACTION `claimref`
+     *
+     * Claim rewards from referred voters whose `next_claim_period` has passed
+     *
+     * > Resumes the `byreferral` index scan after the referral's `cursors` owner and wraps around once exhausted
+     *
+     * A stale cursor (owner unsignup'd or moved to another referral) restarts the scan at the referral's first voter.
+     * The `cursors` row is paid by `get_self()` and erased when the scan wraps around. Voters go through the same
+     * eligibility & referral steps as `claimall`.
+     *
+     * - Authority: `referral` or `get_self()`
+     *
+     * ### params
+     *
+     * - `{name} referral` - referral account
+     * - `{uint64_t} [limit=50]` - maximum number of voters to scan in this transaction
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation claimref '["tokenyieldio"]' -p tokenyieldio
+     * cleos push action proxy4nation claimref '["tokenyieldio", 200]' -p tokenyieldio
+     * ```
+     */
+    [[eosio::action]]
+    void claimref( const name referral, const binary_extension<uint64_t> limit );
+
+    /**
+     * ## ACTION `syncbalance`
+     *
+     * Synchronize treasury balance & runway of reward token with the token contract `accounts` table
+     *
+     * - Authority: `get_self()`
+     *
+     * ### params
+     *
+     * - `{symbol_code} sym_code` - reward token symbol code
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation syncbalance '["DAPP"]' -p proxy4nation
+     * ```
+     */
+    [[eosio::action]]
+    void syncbalance( const symbol_code sym_code );
+
+    /**
+     * ## ACTION `setepoch`
+     *
+     * Publish merkle root of per-owner reward amounts for a claim period
+     *
+     * > Leaves are computed off-chain with `calculate_amount` by `proxy-merkle` (see tools)
+     *
+     * - Authority: `publisher` or `get_self()`
+     * - An existing epoch cannot be overwritten
+     * - One epoch pays every reward token of its period, a second epoch of the same period cannot be claimed by
+     *   owners who already claimed the first
+     * - `totals` must be registered reward tokens & contracts sorted by raw symbol code (`EOS` before `DAPP`),
+     *   `period` cannot be in the future & `expires` must be
+     *
+     * ### params
+     *
+     * - `{uint64_t} epoch` - distribution epoch
+     * - `{checksum256} root` - merkle root
+     * - `{vector<extended_asset>} totals` - total rewards of epoch per token
+     * - `{uint64_t} leaves` - number of leaves in merkle tree
+     * - `{time_point_sec} period` - claim period paid by the epoch (voters due at this time)
+     * - `{time_point_sec} expires` - after which unclaimed rewards return to the treasury
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation setepoch '[1, "5a3d...0a1b", [{"quantity": "12500.0000 EOS", "contract": "eosio.token"}, {"quantity": "2500000.0000 DAPP", "contract": "dappservices"}], 250000, "2019-08-07T00:00:00", "2019-09-07T00:00:00"]' -p eosnationftw
+     * ```
+     */
+    [[eosio::action]]
+    void setepoch( const uint64_t epoch, const checksum256 root, const std::vector<extended_asset>& totals, const uint64_t leaves, const time_point_sec period, const time_point_sec expires );
+
+    /**
+     * ## ACTION `claimproof`
+     *
+     * Claim rewards of an epoch with a merkle proof
+     *
+     * - Authority: `owner` or `referral` or `get_self()`
+     * - Requires `index < leaves`, `amounts` in epoch symbols (order of `totals`) & `claimed + amount <= total` per token
+     * - Requires the voter's `next_claim_period <= period`, which then moves to `period + interval`
+     *   (a claim period is paid either by `claim` or by `claimproof`, never both)
+     *
+     * ### params
+     *
+     * - `{name} owner` - owner account
+     * - `{uint64_t} epoch` - distribution epoch
+     * - `{uint64_t} index` - leaf index of owner
+     * - `{vector<asset>} amounts` - reward amounts of owner, every token of the owner's leaf
+     * - `{vector<checksum256>} proof` - merkle proof from leaf to root
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation claimproof '["myaccount", 1, 195, ["0.2534 EOS", "50.6800 DAPP"], ["b1c2...", "09fe..."]]' -p myaccount
+     * ```
+     */
+    [[eosio::action]]
+    void claimproof( const name owner, const uint64_t epoch, const uint64_t index, const std::vector<asset>& amounts, const std::vector<checksum256>& proof );
+
+    /**
+     * ## ACTION `delepoch`
+     *
+     * Delete expired epoch and its claimed bitmap
+     *
+     * Erases up to `limit` bitmap rows per call (250K leaves => ~3,900 rows), the epoch row is erased with the last
+     * bitmap row; repeat the action until the epoch is gone.
+     *
+     * - Authority: `get_self()`
+     *
+     * ### params
+     *
+     * - `{uint64_t} epoch` - distribution epoch
+     * - `{uint64_t} limit` - maximum bitmap rows to erase
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation delepoch '[1, 500]' -p proxy4nation
+     * ```
+     */
+    [[eosio::action]]
+    void delepoch( const uint64_t epoch, const uint64_t limit );
+
+    /**
+     * ## ACTION `payforcpu`
+     *
+     * Contract pays for CPU of the transaction's other actions, metered per owner per day
+     *
+     * > Must be the first action of the transaction. The transaction is read with `read_transaction`:
+     * > every following action must be a `get_self()` action, its first authorizer is the metered owner.
+     * > `claim` & `signup` use `sponsor_priority_quota`, all other actions use `sponsor_quota`
+     *
+     * - Authority: `payer` or `get_self()@payforcpu`
+     *
+     * ### params
+     *
+     * - `{permission_level} [payer=null]` - (optional) payer authorization, must be a `get_self()` permission
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push transaction '{"actions": [{"account": "proxy4nation", "name": "payforcpu", "authorization": [{"actor": "proxy4nation", "permission": "payforcpu"}], "data": "00"}, {"account": "proxy4nation", "name": "claim", ...}]}'
+     * ```
+     */
     [[eosio::action]]
     void payforcpu( optional<permission_level> payer );
 
+    /**
+     * ## ACTION `prunesponsor`
+     *
+     * Erase `sponsored` rows idle for over 24 hours
+     *
+     * - Authority: `any`
+     *
+     * ### params
+     *
+     * - `{uint64_t} limit` - maximum number of rows to erase
+     *
+     * ### example
+     *
+     * ```bash
+     * cleos push action proxy4nation prunesponsor '[100]' -p myaccount
+     * ```
+     */
+    [[eosio::action]]
+    void prunesponsor( const uint64_t limit );
+
     [[eosio::action]]
     void setparams( const optional<settings_row> params );
 
@@ -749,6 +1198,8 @@ public:
                    const string&  memo );
 
     using claim_action = eosio::action_wrapper<"claim"_n, &proxy::claim>;
+    using claimall_action = eosio::action_wrapper<"claimall"_n, &proxy::claimall>;
+    using claimref_action = eosio::action_wrapper<"claimref"_n, &proxy::claimref>;
     using signup_action = eosio::action_wrapper<"signup"_n, &proxy::signup>;
     using refresh_action = eosio::action_wrapper<"refresh"_n, &proxy::refresh>;
     using setrate_action = eosio::action_wrapper<"setrate"_n, &proxy::setrate>;
@@ -761,6 +1212,9 @@ public:
     using setportfolio_action = eosio::action_wrapper<"setportfolio"_n, &proxy::setportfolio>;
     using delportfolio_action = eosio::action_wrapper<"delportfolio"_n, &proxy::delportfolio>;
     using setreward_action = eosio::action_wrapper<"setreward"_n, &proxy::setreward>;
+    using syncbalance_action = eosio::action_wrapper<"syncbalance"_n, &proxy::syncbalance>;
+    using setepoch_action = eosio::action_wrapper<"setepoch"_n, &proxy::setepoch>;
+    using claimproof_action = eosio::action_wrapper<"claimproof"_n, &proxy::claimproof>;
 
 private:
     // Tables
@@ -771,7 +1225,15 @@ private:
     typedef eosio::multi_index< "staked"_n, staked_row> staked_table;
     typedef eosio::multi_index< "portfolio"_n, portfolio_row> portfolio_table;
     typedef eosio::multi_index< "portfolio2"_n, portfolio2_row> portfolio2_table;
+    typedef eosio::multi_index< "treasury"_n, treasury_row> treasury_table;
+    typedef eosio::multi_index< "cursors"_n, cursors_row> cursors_table;
     typedef eosio::singleton< "settings"_n, settings_row> settings_table;
+    typedef eosio::multi_index< "sponsored"_n, sponsored_row,
+        indexed_by<"byday"_n, const_mem_fun<sponsored_row, uint64_t, &sponsored_row::by_day_start>>
+    > sponsored_table;
+    typedef eosio::singleton< "sponsorship"_n, sponsorship_row> sponsorship_table;
+    typedef eosio::multi_index< "epochs"_n, epochs_row> epochs_table;
+    typedef eosio::multi_index< "claimed"_n, claimed_row> claimed_table;
 
     // Tables v2
     typedef eosio::multi_index< "voters.v2"_n, voters_v2_row,
@@ -781,6 +1243,33 @@ private:
 
     typedef eosio::multi_index< "referrals.v2"_n, referrals_v2_row> referrals_v2_table;
 
+    // `rewards` rows read once per action and shared by every voter of a batch, with the running treasury
+    // balance of each token (payouts are inline transfers, `accounts` rows only move after the action)
+    struct reward_cache {
+        struct entry {
+            rewards_row     reward;
+            asset           balance;
+        };
+        std::array<entry, MAX_REWARDS>  entries;
+        size_t                          count = 0;
+    };
+
+    // table row read into the claim arena, bypassing the multi_index object cache
+    struct raw_row {
+        int32_t     itr = -1;
+        char*       data = nullptr;
+        size_t      size = 0;
+
+        explicit operator bool() const { return itr >= 0; }
+    };
+
+    // `portfolio2` row decoded into fixed capacity
+    struct portfolio_list {
+        std::array<symbol_code, MAX_REWARDS>    rewards;
+        std::array<int64_t, MAX_REWARDS>        percentages;
+        size_t                                  count = 0;
+    };
+
     // local instances of the multi indexes
     voters_v2_table                 _voters;
     settings_table                  _settings;
@@ -789,6 +1278,11 @@ private:
     proxies_table                   _proxies;
     staked_table                    _staked;
     portfolio2_table                _portfolio2;
+    treasury_table                  _treasury;
+    cursors_table                   _cursors;
+    sponsored_table                 _sponsored;
+    sponsorship_table               _sponsorship;
+    epochs_table                    _epochs;
     eosiosystem::voters_table       _eosio_voters;
     eosiosystem::rex_pool_table     _rexpool;
 
@@ -797,12 +1291,18 @@ private:
     void erase_ineligible( const name owner );
     void refresh_claim_period( const name owner );
 
+    // refresh in-memory copy (true if changed), persisted once by `save_voter`
+    bool update_voter_staked( voters_v2_row& voter );
+    bool refresh_claim_period( voters_v2_row& voter, const int64_t interval );
+    void save_voter( const voters_v2_table::const_iterator itr, const voters_v2_row& voter );
+
     // utils
     void check_voter_exists( const name owner );
 
     // claim
     int64_t calculate_amount( const symbol_code sym_code, const int64_t staked, const int64_t multiplier, const int64_t rate, const int64_t interval );
     void send_referral( const name owner, const asset quantity, const name contract );
+    bool claim_voter( const name owner, const settings_row& settings, reward_cache& cache, reward_list& rewards );
 
     // proxies
     name get_voter_proxy( const name owner );
@@ -819,12 +1319,33 @@ private:
     // claim
     void stake_to( const name receiver, const int64_t amount );
     void rex_to( const name receiver, const int64_t amount );
-    std::vector<asset> send_rewards( const name owner, const int64_t staked );
+    void send_rewards( const name owner, const int64_t staked, const settings_row& settings, reward_cache& cache, reward_list& rewards );
+    void send_referrals( const name owner, const settings_row& settings, reward_cache& cache, const reward_list& rewards );
+    void send_receipt( const name owner, const asset staked, const reward_list& rewards );
+
+    // claim path raw table access (no multi_index cache, scratch memory from `claim_arena`)
+    static bump_arena& claim_arena();
+    raw_row read_row( const name code, const uint64_t scope, const name table, const uint64_t primary_key );
+    uint64_t voters_index( const uint64_t number );
+    int64_t get_eosio_staked( const name owner );
+    bool get_portfolio( const name owner, portfolio_list& portfolio );
     void send_reward( const name owner, const asset quantity, const name contract );
 
     // settings
     void check_pause();
 
+    // merkle
+    checksum256 merkle_leaf( const uint64_t index, const name owner, const std::vector<asset>& amounts );
+    checksum256 merkle_node( const checksum256& left, const checksum256& right );
+    uint64_t merkle_depth( const uint64_t leaves );
+    void check_merkle_proof( const checksum256& root, const checksum256& leaf, const uint64_t index, const uint64_t leaves, const std::vector<checksum256>& proof );
+    void set_claimed( const uint64_t epoch, const uint64_t index );
+
+    // sponsorship
+    void check_sponsor( const name owner, const name action_name );
+    bool is_priority_sponsor( const name action_name );
+    void prune_sponsored( const uint64_t limit );
+
     // price
     asset get_usdt_price();
     asset get_dapp_price();
@@ -837,9 +1358,16 @@ private:
 
     // rewards
     void check_reward_exists( const symbol_code sym_code );
+    reward_cache::entry& get_reward( reward_cache& cache, const symbol_code sym_code );
+
+    // treasury
+    asset get_treasury_balance( const rewards_row& reward );
+    void update_treasury( const rewards_row& reward, const asset paid, const asset balance );
+    asset pay_reward( const name owner, const asset quantity, const bool staked, reward_cache& cache );
+    void deliver_reward( const name owner, const asset quantity, const name contract, const bool staked );
 
     // portfolio
-    void set_portfolio_rewards( const name owner, const std::vector<symbol_code> rewards, const std::vector<int64_t> percentages );
+    void set_portfolio_rewards( const name owner, const std::vector<symbol_code>& rewards, const std::vector<int64_t>& percentages );
     name has_portfolio( const name owner );
     void update_reward_percentage( const symbol_code code, const int64_t percentage );
     double get_current_price( const uint64_t pair_id );
@@ -0,0 +1,205 @@
+#include "../proxy.hpp"
+
+using namespace eosio::internal_use_do_not_use;
+
+bool proxy::claim_voter( const name owner, const settings_row& settings, reward_cache& cache, reward_list& rewards )
+{
+    // every buffer of the previous voter is released, WASM memory stays flat over a batch
+    claim_arena().reset();
+    rewards.clear();
+
+    // same eligibility as `claim`, voters who no longer proxy to a registered proxy are signed out
+    erase_ineligible( owner );
+
+    // fixed-size head of `voters_v2_row` (owner, next_claim_period, staked, referral), set & map are never decoded
+    const raw_row row = read_row( get_self(), get_self().value, "voters.v2"_n, owner.value );
+    if ( !row ) return false;
+    check( row.size >= 28, "proxy::claim: invalid voter" );
+
+    uint32_t next_claim_period;
+    std::memcpy( &next_claim_period, row.data + 8, sizeof( next_claim_period ) );
+    const uint32_t now = current_time_point().sec_since_epoch();
+    if ( next_claim_period > now ) return false;
+
+    // `claim` fails with `check_active_proxy`, a batch cannot stall on the voter: the period passes unpaid
+    const int64_t staked = get_eosio_staked( owner );
+    const uint32_t next = now + static_cast<uint32_t>( settings.interval );
+    const auto proxy = _proxies.find( get_voter_proxy( owner ).value );
+    if ( proxy != _proxies.end() && proxy->active ) {
+        send_rewards( owner, staked, settings, cache, rewards );
+
+        uint64_t referral;
+        std::memcpy( &referral, row.data + 20, sizeof( referral ) );
+        if ( referral ) send_referrals( owner, settings, cache, rewards );
+    }
+
+    // single write of the patched row, `bynextclaim` is the only secondary key that moves (`byreferral` never does)
+    std::memcpy( row.data + 8, &next, sizeof( next ) );
+    std::memcpy( row.data + 12, &staked, sizeof( staked ) );
+    db_update_i64( row.itr, 0, row.data, row.size );
+    if ( next != next_claim_period ) {
+        uint64_t secondary = 0;
+        const int32_t itr = db_idx64_find_primary( get_self().value, get_self().value, voters_index( 0 ), &secondary, owner.value );
+        const uint64_t key = next;
+        db_idx64_update( itr, 0, &key );
+    }
+
+    send_receipt( owner, asset{ staked, symbol{"EOS", 4} }, rewards );
+    return true;
+}
+
+void proxy::send_referrals( const name owner, const settings_row& settings, reward_cache& cache, const reward_list& rewards )
+{
+    // `send_referral` pays `referral_rate` of each payout on top of it, drawn from the same running balance
+    for ( const asset& paid : rewards ) {
+        auto& token = get_reward( cache, paid.symbol.code() );
+        const asset share = asset{ static_cast<int64_t>( static_cast<int128_t>( paid.amount ) * settings.referral_rate / 10000 ), paid.symbol };
+        if ( share.amount <= 0 || token.balance < share ) continue;
+
+        send_referral( owner, paid, token.reward.contract );
+        token.balance -= share;
+        update_treasury( token.reward, share, token.balance );
+    }
+}
+
+proxy::reward_cache::entry& proxy::get_reward( reward_cache& cache, const symbol_code sym_code )
+{
+    for ( size_t i = 0; i < cache.count; ++i ) {
+        if ( cache.entries[i].reward.symbol.code() == sym_code ) return cache.entries[i];
+    }
+    // `setreward` caps registered tokens at MAX_REWARDS, every token of a batch has its running balance
+    check( cache.count < cache.entries.size(), "proxy::claim: exceeds maximum reward tokens" );
+    auto& entry = cache.entries[cache.count++];
+    entry.reward = _rewards.get( sym_code.raw(), "proxy::claim: reward symbol does not exist" );
+    entry.balance = get_treasury_balance( entry.reward );
+    return entry;
+}
+
+void proxy::send_rewards( const name owner, const int64_t staked, const settings_row& settings, reward_cache& cache, reward_list& rewards )
+{
+    const bool staked_rewards = is_staked( owner );
+
+    auto pay = [&]( const symbol_code sym_code, const int64_t percentage ) {
+        const rewards_row& reward = get_reward( cache, sym_code ).reward;
+        const int64_t amount = calculate_amount( sym_code, staked, percentage, settings.rate, settings.interval );
+
+        // under-funded tokens are redirected to EOS or skipped by `pay_reward`, never failing the claim
+        const asset paid = pay_reward( owner, asset{ amount, reward.symbol }, staked_rewards, cache );
+        if ( paid.amount > 0 ) rewards.add( paid );
+    };
+
+    portfolio_list portfolio;
+    if ( !get_portfolio( owner, portfolio ) ) {
+        pay( symbol_code{"EOS"}, 10000 );
+        return;
+    }
+    for ( size_t i = 0; i < portfolio.count; ++i ) {
+        pay( portfolio.rewards[i], portfolio.percentages[i] );
+    }
+}
+
+void proxy::send_receipt( const name owner, const asset staked, const reward_list& rewards )
+{
+    // packed `receipt` inline action (same bytes as `receipt_action::send`) without vector payload & authorization
+    auto pack_data = [&]( auto& ds ) {
+        ds << owner << staked << unsigned_int( rewards.size() );
+        for ( const asset& quantity : rewards ) ds << quantity;
+    };
+    datastream<size_t> data_size;
+    pack_data( data_size );
+
+    auto pack_header = [&]( auto& ds ) {
+        ds << get_self() << "receipt"_n << unsigned_int( 1 ) << permission_level{ get_self(), "active"_n } << unsigned_int( data_size.tellp() );
+    };
+    datastream<size_t> header_size;
+    pack_header( header_size );
+
+    const size_t size = header_size.tellp() + data_size.tellp();
+    char* data = claim_arena().allocate( size );
+    datastream<char*> ds( data, size );
+    pack_header( ds );
+    pack_data( ds );
+    send_inline( data, size );
+}
+
+bump_arena& proxy::claim_arena()
+{
+    static bump_arena arena;
+    return arena;
+}
+
+proxy::raw_row proxy::read_row( const name code, const uint64_t scope, const name table, const uint64_t primary_key )
+{
+    raw_row row;
+    row.itr = db_find_i64( code.value, scope, table.value, primary_key );
+    if ( row.itr < 0 ) return row;
+
+    row.size = db_get_i64( row.itr, nullptr, 0 );
+    row.data = claim_arena().allocate( row.size );
+    db_get_i64( row.itr, row.data, row.size );
+    return row;
+}
+
+uint64_t proxy::voters_index( const uint64_t number )
+{
+    // secondary index table of `voters.v2` as named by multi_index (0 = `bynextclaim`, 1 = `byreferral`)
+    return ( "voters.v2"_n.value & 0xFFFFFFFFFFFFFFF0ULL ) | ( number & 0xFULL );
+}
+
+int64_t proxy::get_eosio_staked( const name owner )
+{
+    const int32_t itr = db_find_i64( "eosio"_n.value, "eosio"_n.value, "voters"_n.value, owner.value );
+    if ( itr < 0 ) return 0;
+
+    // `voter_info` head: owner, proxy, producers (max 30), staked; a partial read stops after `staked`
+    char data[16 + 5 + 30 * 8 + 8];
+    const uint32_t size = std::min<uint32_t>( db_get_i64( itr, data, sizeof( data ) ), sizeof( data ) );
+    datastream<const char*> ds( data, size );
+    ds.skip( 16 );
+    unsigned_int producers;
+    ds >> producers;
+    ds.skip( producers.value * 8 );
+    int64_t staked = 0;
+    ds >> staked;
+    return staked;
+}
+
+bool proxy::get_portfolio( const name owner, portfolio_list& portfolio )
+{
+    const raw_row row = read_row( get_self(), get_self().value, "portfolio2"_n, owner.value );
+    if ( !row ) return false;
+
+    datastream<const char*> ds( row.data, row.size );
+    ds.skip( 8 );
+
+    // `setportfolio` caps portfolios at MAX_REWARDS, older rows keep MAX_REWARDS - 1 tokens and the rest goes to EOS
+    unsigned_int size;
+    ds >> size;
+    const size_t keep = size.value <= MAX_REWARDS ? size.value : MAX_REWARDS - 1;
+    for ( size_t i = 0; i < keep; ++i ) ds >> portfolio.rewards[i];
+    ds.skip( ( size.value - keep ) * sizeof( symbol_code ) );
+
+    unsigned_int percentages;
+    ds >> percentages;
+    check( percentages.value == size.value, "proxy::claim: invalid portfolio" );
+    int64_t folded = 0;
+    for ( size_t i = 0; i < size.value; ++i ) {
+        int64_t percentage;
+        ds >> percentage;
+        if ( i < keep ) portfolio.percentages[i] = percentage;
+        else folded += percentage;
+    }
+    portfolio.count = keep;
+    if ( !folded ) return true;
+
+    const symbol_code EOS = symbol_code{"EOS"};
+    for ( size_t i = 0; i < keep; ++i ) {
+        if ( portfolio.rewards[i] == EOS ) {
+            portfolio.percentages[i] += folded;
+            return true;
+        }
+    }
+    portfolio.rewards[portfolio.count] = EOS;
+    portfolio.percentages[portfolio.count++] = folded;
+    return true;
+}
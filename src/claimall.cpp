@@ -0,0 +1,22 @@
+#include "../proxy.hpp"
+
+void proxy::claimall( const binary_extension<uint64_t> limit )
+{
+    require_auth( get_self() );
+    check_pause();
+
+    const uint64_t now = current_time_point().sec_since_epoch();
+    const settings_row settings = _settings.get_or_default();
+    reward_cache cache;
+    reward_list rewards;
+
+    // claimed voters move past `now` in the index, so the oldest due voter is always at the front;
+    // the index is read raw so no voter row is loaded into a multi_index cache
+    const uint64_t bynextclaim = voters_index( 0 );
+    for ( uint64_t remaining = limit.value_or( CLAIMALL_LIMIT ); remaining > 0; --remaining ) {
+        uint64_t next_claim_period = 0, owner = 0;
+        const int32_t itr = internal_use_do_not_use::db_idx64_lowerbound( get_self().value, get_self().value, bynextclaim, &next_claim_period, &owner );
+        if ( itr < 0 || next_claim_period > now ) break;
+        claim_voter( name{ owner }, settings, cache, rewards );
+    }
+}
@@ -0,0 +1,59 @@
+#include "../proxy.hpp"
+
+using namespace eosio::internal_use_do_not_use;
+
+void proxy::claimref( const name referral, const binary_extension<uint64_t> limit )
+{
+    check( has_auth( referral ) || has_auth( get_self() ), "proxy::claimref: missing authority of referral" );
+    check_pause();
+
+    const uint64_t batch = limit.value_or( CLAIMALL_LIMIT );
+    check( referral.value, "proxy::claimref: referral cannot be empty" );
+    check( batch > 0, "proxy::claimref: limit must be positive" );
+
+    const settings_row settings = _settings.get_or_default();
+    reward_cache cache;
+    reward_list rewards;
+
+    // `byreferral` orders a referral's voters by owner, read raw so no voter row is loaded into a multi_index cache
+    const uint64_t self = get_self().value;
+    const uint64_t byreferral = voters_index( 1 );
+    uint64_t secondary = referral.value, owner = 0;
+    int32_t itr = db_idx64_lowerbound( self, self, byreferral, &secondary, &owner );
+
+    // resume right after the cursor owner, a stale cursor (owner unsignup'd or moved to another referral)
+    // keeps the lower bound of the referral's range
+    auto cursor = _cursors.find( referral.value );
+    if ( cursor != _cursors.end() ) {
+        uint64_t cursor_referral = 0;
+        const int32_t at = db_idx64_find_primary( self, self, byreferral, &cursor_referral, cursor->owner.value );
+        if ( at >= 0 && cursor_referral == referral.value ) {
+            itr = db_idx64_next( at, &owner );
+            if ( itr >= 0 ) db_idx64_find_primary( self, self, byreferral, &secondary, owner );
+        }
+    }
+
+    name last;
+    for ( uint64_t remaining = batch; remaining > 0 && itr >= 0 && secondary == referral.value; --remaining ) {
+        last = name{ owner };
+
+        // step past the voter first, `claim_voter` erases an ineligible voter along with its `byreferral` entry
+        itr = db_idx64_next( itr, &owner );
+        claim_voter( last, settings, cache, rewards );
+        if ( itr >= 0 ) db_idx64_find_primary( self, self, byreferral, &secondary, owner );
+    }
+
+    // range exhausted => drop the cursor, the next call wraps around to the referral's first voter
+    if ( itr < 0 || secondary != referral.value ) {
+        if ( cursor != _cursors.end() ) _cursors.erase( cursor );
+    } else if ( cursor == _cursors.end() ) {
+        _cursors.emplace( get_self(), [&]( auto& row ) {
+            row.referral = referral;
+            row.owner = last;
+        });
+    } else {
+        _cursors.modify( cursor, same_payer, [&]( auto& row ) {
+            row.owner = last;
+        });
+    }
+}
@@ -0,0 +1,163 @@
+#include "../proxy.hpp"
+
+void proxy::setepoch( const uint64_t epoch, const checksum256 root, const std::vector<extended_asset>& totals, const uint64_t leaves, const time_point_sec period, const time_point_sec expires )
+{
+    const name publisher = _settings.get_or_default().publisher.value_or( name{} );
+    check( has_auth( get_self() ) || ( publisher.value && has_auth( publisher ) ), "proxy::setepoch: missing authority of publisher" );
+
+    // published roots are immutable, owners may already hold proofs against them
+    check( _epochs.find( epoch ) == _epochs.end(), "proxy::setepoch: epoch already exists" );
+    check( root != checksum256{}, "proxy::setepoch: root cannot be empty" );
+    check( leaves > 0, "proxy::setepoch: leaves must be positive" );
+    check( !totals.empty() && totals.size() <= MAX_REWARDS, "proxy::setepoch: totals must have 1 to " + std::to_string( MAX_REWARDS ) + " reward tokens" );
+
+    // one epoch pays every token of the period, leaf amounts follow the order of `totals`
+    std::vector<asset> claimed;
+    for ( const extended_asset& total : totals ) {
+        check( total.quantity.is_valid() && total.quantity.amount > 0, "proxy::setepoch: total must be positive" );
+        check( claimed.empty() || claimed.back().symbol.code() < total.quantity.symbol.code(), "proxy::setepoch: totals must be sorted by symbol code without duplicates" );
+
+        const auto reward = _rewards.get( total.quantity.symbol.code().raw(), "proxy::setepoch: reward symbol does not exist" );
+        check( reward.symbol == total.quantity.symbol && reward.contract == total.contract, "proxy::setepoch: total must match the registered reward token" );
+        claimed.push_back( asset{ 0, total.quantity.symbol } );
+    }
+
+    const time_point_sec now = current_time_point();
+    check( period <= now, "proxy::setepoch: period cannot be in the future" );
+    check( expires > now, "proxy::setepoch: expires must be in the future" );
+
+    _epochs.emplace( get_self(), [&]( auto& row ) {
+        row.epoch = epoch;
+        row.root = root;
+        row.totals = totals;
+        row.claimed = claimed;
+        row.leaves = leaves;
+        row.period = period;
+        row.expires = expires;
+    });
+}
+
+void proxy::claimproof( const name owner, const uint64_t epoch, const uint64_t index, const std::vector<asset>& amounts, const std::vector<checksum256>& proof )
+{
+    check_pause();
+
+    auto voter = _voters.require_find( owner.value, "proxy::claimproof: voter does not exist" );
+    check( has_auth( owner ) || has_auth( voter->referral ) || has_auth( get_self() ), "proxy::claimproof: missing authority of owner" );
+
+    const auto& row = _epochs.get( epoch, "proxy::claimproof: epoch does not exist" );
+    check( current_time_point() < row.expires, "proxy::claimproof: epoch has expired" );
+    check( index < row.leaves, "proxy::claimproof: index out of range" );
+    check( !amounts.empty(), "proxy::claimproof: amounts cannot be empty" );
+
+    // amounts are a subsequence of the epoch totals, positions of `totals` they pay
+    std::vector<size_t> positions;
+    size_t position = 0;
+    for ( const asset& amount : amounts ) {
+        while ( position < row.totals.size() && row.totals[position].quantity.symbol != amount.symbol ) ++position;
+        check( position < row.totals.size(), "proxy::claimproof: amounts must be epoch symbols in the order of totals" );
+        check( amount.amount > 0, "proxy::claimproof: amount must be positive" );
+        check( row.totals[position].quantity - row.claimed[position] >= amount, "proxy::claimproof: amount exceeds unclaimed epoch total" );
+        positions.push_back( position++ );
+    }
+
+    // the epoch pays the claim period due at `period`, a voter who has since claimed it with `claim` is excluded
+    check( voter->next_claim_period <= row.period, "proxy::claimproof: claim period already paid" );
+
+    check_merkle_proof( row.root, merkle_leaf( index, owner, amounts ), index, row.leaves, proof );
+    set_claimed( epoch, index );
+
+    const time_point_sec next_claim_period = row.period + static_cast<uint32_t>( _settings.get_or_default().interval );
+    _epochs.modify( row, same_payer, [&]( auto& row ) {
+        for ( size_t i = 0; i < amounts.size(); ++i ) row.claimed[positions[i]] += amounts[i];
+    });
+    _voters.modify( voter, same_payer, [&]( auto& row ) {
+        row.next_claim_period = next_claim_period;
+    });
+
+    // epoch rewards are held in the treasury until claimed, unclaimed amounts simply remain there
+    const bool staked = is_staked( owner );
+    for ( size_t i = 0; i < amounts.size(); ++i ) {
+        const auto reward = _rewards.get( amounts[i].symbol.code().raw(), "proxy::claimproof: reward symbol does not exist" );
+        const asset balance = get_treasury_balance( reward );
+        check( balance >= amounts[i], "proxy::claimproof: treasury balance is insufficient" );
+        deliver_reward( owner, amounts[i], row.totals[positions[i]].contract, staked );
+        update_treasury( reward, amounts[i], balance - amounts[i] );
+    }
+}
+
+void proxy::delepoch( const uint64_t epoch, const uint64_t limit )
+{
+    require_auth( get_self() );
+
+    const auto& row = _epochs.get( epoch, "proxy::delepoch: epoch does not exist" );
+    check( current_time_point() >= row.expires, "proxy::delepoch: epoch has not expired" );
+    check( limit > 0, "proxy::delepoch: limit must be positive" );
+
+    claimed_table claimed( get_self(), epoch );
+    auto itr = claimed.begin();
+    for ( uint64_t erased = 0; itr != claimed.end() && erased < limit; ++erased ) {
+        itr = claimed.erase( itr );
+    }
+    // epoch row goes last, an epoch number cannot be re-published over a partially erased bitmap
+    if ( itr == claimed.end() ) _epochs.erase( row );
+}
+
+checksum256 proxy::merkle_leaf( const uint64_t index, const name owner, const std::vector<asset>& amounts )
+{
+    // leaf = sha256( index:u64 | owner:u64 | count:varuint32 | (amount:i64 | symbol:u64)... ), little-endian
+    // 17 + 16 * count bytes, never the 64 bytes of a node
+    std::array<char, 17 + 16 * MAX_REWARDS> data;
+    check( amounts.size() <= MAX_REWARDS, "proxy::claimproof: too many amounts" );
+    eosio::datastream<char*> ds( data.data(), data.size() );
+    ds << index << owner << amounts;
+    return sha256( data.data(), ds.tellp() );
+}
+
+checksum256 proxy::merkle_node( const checksum256& left, const checksum256& right )
+{
+    // node = sha256( left | right ), 64 bytes, leaves hash an odd length so a node can never pass as a leaf
+    std::array<uint8_t, 64> data;
+    const auto l = left.extract_as_byte_array();
+    const auto r = right.extract_as_byte_array();
+    std::copy( l.begin(), l.end(), data.begin() );
+    std::copy( r.begin(), r.end(), data.begin() + 32 );
+    return sha256( reinterpret_cast<const char*>( data.data() ), data.size() );
+}
+
+uint64_t proxy::merkle_depth( const uint64_t leaves )
+{
+    // levels with an odd node count pair their last node with itself
+    uint64_t depth = 0;
+    for ( uint64_t width = leaves; width > 1; width = ( width + 1 ) / 2 ) ++depth;
+    return depth;
+}
+
+void proxy::check_merkle_proof( const checksum256& root, const checksum256& leaf, const uint64_t index, const uint64_t leaves, const std::vector<checksum256>& proof )
+{
+    check( proof.size() == merkle_depth( leaves ), "proxy::claimproof: invalid proof length" );
+
+    checksum256 node = leaf;
+    for ( size_t i = 0; i < proof.size(); ++i ) {
+        node = ( index >> i ) & 1 ? merkle_node( proof[i], node ) : merkle_node( node, proof[i] );
+    }
+    check( node == root, "proxy::claimproof: invalid merkle proof" );
+}
+
+void proxy::set_claimed( const uint64_t epoch, const uint64_t index )
+{
+    claimed_table claimed( get_self(), epoch );
+    const uint64_t bit = 1ULL << ( index % 64 );
+
+    auto itr = claimed.find( index / 64 );
+    if ( itr == claimed.end() ) {
+        claimed.emplace( get_self(), [&]( auto& row ) {
+            row.word = index / 64;
+            row.bits = bit;
+        });
+        return;
+    }
+    check( !( itr->bits & bit ), "proxy::claimproof: already claimed" );
+    claimed.modify( itr, same_payer, [&]( auto& row ) {
+        row.bits |= bit;
+    });
+}
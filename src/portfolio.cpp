@@ -0,0 +1,45 @@
+#include "../proxy.hpp"
+
+void proxy::setportfolio( const name owner, const std::vector<symbol_code> rewards, const std::vector<int64_t> percentages )
+{
+    if ( !has_auth( get_self() ) ) require_auth( owner );
+    check_pause();
+    check_voter_exists( owner );
+
+    set_portfolio_rewards( owner, rewards, percentages );
+}
+
+void proxy::set_portfolio_rewards( const name owner, const std::vector<symbol_code>& rewards, const std::vector<int64_t>& percentages )
+{
+    check( !rewards.empty(), "proxy::setportfolio: rewards cannot be empty" );
+    check( rewards.size() == percentages.size(), "proxy::setportfolio: rewards and percentages must be the same size" );
+
+    // bounded by the fixed-capacity claim path (`reward_list` & `portfolio_list`)
+    check( rewards.size() <= MAX_REWARDS, "proxy::setportfolio: maximum of " + std::to_string( MAX_REWARDS ) + " reward tokens" );
+
+    int64_t total = 0;
+    for ( size_t i = 0; i < rewards.size(); ++i ) {
+        check_reward_exists( rewards[i] );
+        check( percentages[i] > 0, "proxy::setportfolio: percentage must be positive" );
+        for ( size_t j = 0; j < i; ++j ) {
+            check( rewards[j] != rewards[i], "proxy::setportfolio: duplicate reward " + rewards[i].to_string() );
+        }
+        total += percentages[i];
+    }
+    check( total == 10000, "proxy::setportfolio: percentages must add up to 100%" );
+
+    auto update = [&]( auto& row ) {
+        row.owner = owner;
+        row.rewards = rewards;
+        row.percentages = percentages;
+    };
+    auto portfolio = _portfolio2.find( owner.value );
+    if ( portfolio == _portfolio2.end() ) _portfolio2.emplace( get_self(), update );
+    else _portfolio2.modify( portfolio, same_payer, update );
+
+    // `voters.v2` rewards mirror the portfolio tokens
+    const auto itr = _voters.require_find( owner.value, "proxy::setportfolio: voter does not exist" );
+    voters_v2_row voter = *itr;
+    voter.rewards = set<symbol_code>( rewards.begin(), rewards.end() );
+    save_voter( itr, voter );
+}
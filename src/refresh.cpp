@@ -0,0 +1,60 @@
+#include "../proxy.hpp"
+
+void proxy::refresh( const name voter )
+{
+    require_auth( get_self() );
+
+    erase_ineligible( voter );
+    const auto itr = _voters.find( voter.value );
+    if ( itr == _voters.end() ) return;
+
+    // every change lands on one copy => at most one `modify`, none for an unchanged voter
+    voters_v2_row updated = *itr;
+    update_voter_staked( updated );
+    refresh_claim_period( updated, _settings.get_or_default().interval );
+    save_voter( itr, updated );
+}
+
+void proxy::update_voter_staked( const name owner )
+{
+    const auto itr = _voters.require_find( owner.value, "proxy::update_voter_staked: voter does not exist" );
+    voters_v2_row updated = *itr;
+    if ( update_voter_staked( updated ) ) save_voter( itr, updated );
+}
+
+void proxy::refresh_claim_period( const name owner )
+{
+    const auto itr = _voters.require_find( owner.value, "proxy::refresh_claim_period: voter does not exist" );
+    voters_v2_row updated = *itr;
+    if ( refresh_claim_period( updated, _settings.get_or_default().interval ) ) save_voter( itr, updated );
+}
+
+bool proxy::update_voter_staked( voters_v2_row& voter )
+{
+    const int64_t staked = get_eosio_staked( voter.owner );
+    if ( voter.staked == staked ) return false;
+
+    voter.staked = staked;
+    return true;
+}
+
+bool proxy::refresh_claim_period( voters_v2_row& voter, const int64_t interval )
+{
+    // a shortened interval (`setinterval`) pulls waiting voters forward, it never pushes them back
+    const time_point_sec latest = time_point_sec( current_time_point() ) + static_cast<uint32_t>( interval );
+    if ( voter.next_claim_period <= latest ) return false;
+
+    voter.next_claim_period = latest;
+    return true;
+}
+
+void proxy::save_voter( const voters_v2_table::const_iterator itr, const voters_v2_row& voter )
+{
+    check( itr->owner == voter.owner, "proxy::save_voter: owner cannot change" );
+    if ( *itr == voter ) return;
+
+    // `modify` re-indexes `bynextclaim` & `byreferral` only when their key changed
+    _voters.modify( itr, same_payer, [&]( auto& row ) {
+        row = voter;
+    });
+}
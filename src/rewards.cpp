@@ -0,0 +1,27 @@
+#include "../proxy.hpp"
+
+void proxy::setreward( const symbol sym, const name contract, const asset price )
+{
+    require_auth( get_self() );
+
+    check( sym.is_valid(), "proxy::setreward: invalid symbol" );
+    check( is_account( contract ), "proxy::setreward: contract does not exist" );
+    check( price.symbol == symbol{"EOS", 4} && price.amount > 0, "proxy::setreward: price must be a positive EOS amount" );
+
+    auto update = [&]( auto& row ) {
+        row.symbol = sym;
+        row.contract = contract;
+        row.price = price;
+    };
+    auto itr = _rewards.find( sym.code().raw() );
+    if ( itr != _rewards.end() ) {
+        _rewards.modify( itr, same_payer, update );
+        return;
+    }
+
+    // registered tokens bound every portfolio & the claim path `reward_cache`
+    size_t count = 0;
+    for ( auto reward = _rewards.begin(); reward != _rewards.end(); ++reward ) ++count;
+    check( count < MAX_REWARDS, "proxy::setreward: maximum of " + std::to_string( MAX_REWARDS ) + " reward tokens" );
+    _rewards.emplace( get_self(), update );
+}
@@ -0,0 +1,90 @@
+#include "../proxy.hpp"
+
+void proxy::payforcpu( optional<permission_level> payer )
+{
+    // quotas meter the contract's CPU, another payer would spend the owners' quota on CPU it pays itself
+    check( !payer || payer->actor == get_self(), "proxy::payforcpu: payer must be " + get_self().to_string() );
+    require_auth( payer ? *payer : permission_level{ get_self(), "payforcpu"_n } );
+
+    // owners & actions are taken from the transaction itself, `payforcpu` must come first
+    const size_t size = transaction_size();
+    std::vector<char> buffer( size );
+    read_transaction( buffer.data(), size );
+    const transaction trx = unpack<transaction>( buffer.data(), size );
+
+    check( trx.context_free_actions.empty(), "proxy::payforcpu: context free actions are not sponsored" );
+    check( trx.actions.size() >= 2, "proxy::payforcpu: no action to sponsor" );
+    check( trx.actions[0].account == get_self() && trx.actions[0].name == "payforcpu"_n, "proxy::payforcpu: must be the first action" );
+
+    for ( size_t i = 1; i < trx.actions.size(); ++i ) {
+        const action& act = trx.actions[i];
+        check( act.account == get_self(), "proxy::payforcpu: only " + get_self().to_string() + " actions are sponsored" );
+        check( act.name != "payforcpu"_n, "proxy::payforcpu: must be the only payforcpu action" );
+        check( !act.authorization.empty(), "proxy::payforcpu: sponsored action requires an authorization" );
+
+        const name owner = act.authorization[0].actor;
+        if ( owner != get_self() ) check_sponsor( owner, act.name );
+    }
+
+    // amortized cleanup keeps `sponsored` bounded to owners active during the last day
+    prune_sponsored( 1 );
+}
+
+void proxy::prunesponsor( const uint64_t limit )
+{
+    prune_sponsored( limit );
+}
+
+bool proxy::is_priority_sponsor( const name action_name )
+{
+    return action_name == "claim"_n || action_name == "signup"_n;
+}
+
+void proxy::check_sponsor( const name owner, const name action_name )
+{
+    const settings_row settings = _settings.get_or_default();
+    const bool priority = is_priority_sponsor( action_name );
+    const int64_t quota = priority ? settings.sponsor_priority_quota.value_or( SPONSOR_PRIORITY_QUOTA ) : settings.sponsor_quota.value_or( SPONSOR_QUOTA );
+    const time_point_sec now = current_time_point();
+
+    auto update = [&]( auto& row ) {
+        if ( now >= row.day_start + static_cast<uint32_t>( DAY ) ) {
+            row.day_start = now;
+            row.count = 0;
+            row.priority_count = 0;
+        }
+        int64_t& used = priority ? row.priority_count : row.count;
+        check( used < quota, "proxy::payforcpu: daily sponsorship quota exceeded for " + owner.to_string() );
+        used += 1;
+        row.total += 1;
+    };
+
+    auto itr = _sponsored.find( owner.value );
+    if ( itr == _sponsored.end() ) {
+        _sponsored.emplace( get_self(), [&]( auto& row ) {
+            row.owner = owner;
+            row.day_start = now;
+            update( row );
+        });
+    } else {
+        _sponsored.modify( itr, same_payer, update );
+    }
+
+    auto stats = _sponsorship.get_or_default();
+    stats.total += 1;
+    if ( action_name == "claim"_n ) stats.claims += 1;
+    if ( action_name == "signup"_n ) stats.signups += 1;
+    _sponsorship.set( stats, get_self() );
+}
+
+void proxy::prune_sponsored( const uint64_t limit )
+{
+    const uint64_t now = current_time_point().sec_since_epoch();
+    auto index = _sponsored.get_index<"byday"_n>();
+
+    uint64_t erased = 0;
+    for ( auto itr = index.begin(); itr != index.end() && erased < limit; ++erased ) {
+        if ( itr->by_day_start() + DAY > now ) break;
+        itr = index.erase( itr );
+    }
+}
@@ -0,0 +1,99 @@
+#include "../proxy.hpp"
+
+void proxy::syncbalance( const symbol_code sym_code )
+{
+    require_auth( get_self() );
+
+    const auto reward = _rewards.get( sym_code.raw(), "proxy::syncbalance: reward symbol does not exist" );
+    update_treasury( reward, asset{ 0, reward.symbol }, get_treasury_balance( reward ) );
+}
+
+asset proxy::get_treasury_balance( const rewards_row& reward )
+{
+    // only the token contract registered in `rewards` is trusted, spam tokens with the same symbol are never counted
+    const int32_t itr = internal_use_do_not_use::db_find_i64( reward.contract.value, get_self().value, "accounts"_n.value, reward.symbol.code().raw() );
+    if ( itr < 0 ) return asset{ 0, reward.symbol };
+
+    // `accounts` rows are a single asset, read in place instead of through a per-call `token::accounts` cache
+    char data[16];
+    internal_use_do_not_use::db_get_i64( itr, data, sizeof( data ) );
+    asset balance;
+    datastream<const char*> ds( data, sizeof( data ) );
+    ds >> balance;
+    return balance;
+}
+
+void proxy::update_treasury( const rewards_row& reward, const asset paid, const asset balance )
+{
+    const time_point_sec now = current_time_point();
+    const asset zero = asset{ 0, reward.symbol };
+
+    auto update = [&]( auto& row ) {
+        // roll 24 hour payout window, previous window is dropped if no payout happened for over a day
+        if ( now >= row.window_start + static_cast<uint32_t>( DAY ) ) {
+            row.last_paid = now < row.window_start + static_cast<uint32_t>( 2 * DAY ) ? row.paid : zero;
+            row.paid = zero;
+            row.window_start = now;
+        }
+        row.balance = extended_asset{ balance, reward.contract };
+        row.paid += paid;
+
+        // payout rate (per second) from the previous full window, or the current window until one exists
+        const int64_t elapsed = std::max<int64_t>( now.sec_since_epoch() - row.window_start.sec_since_epoch(), 1 );
+        if ( row.last_paid.amount > 0 ) row.runway = static_cast<int64_t>( static_cast<int128_t>( balance.amount ) * DAY / row.last_paid.amount );
+        else if ( row.paid.amount > 0 ) row.runway = static_cast<int64_t>( static_cast<int128_t>( balance.amount ) * elapsed / row.paid.amount );
+        else row.runway = -1;
+    };
+
+    auto itr = _treasury.find( reward.symbol.code().raw() );
+    if ( itr == _treasury.end() ) {
+        _treasury.emplace( get_self(), [&]( auto& row ) {
+            row.sym_code = reward.symbol.code();
+            row.paid = zero;
+            row.last_paid = zero;
+            row.window_start = now;
+            update( row );
+        });
+    } else {
+        _treasury.modify( itr, same_payer, update );
+    }
+}
+
+void proxy::deliver_reward( const name owner, const asset quantity, const name contract, const bool staked )
+{
+    if ( staked && quantity.symbol.code() == symbol_code{"EOS"} ) stake_to( owner, quantity.amount );
+    else send_reward( owner, quantity, contract );
+}
+
+asset proxy::pay_reward( const name owner, const asset quantity, const bool staked, reward_cache& cache )
+{
+    auto& token = get_reward( cache, quantity.symbol.code() );
+    if ( quantity.amount <= 0 ) return quantity;
+
+    // drawn from the running balance of the batch, the treasury row records what is left after each payout
+    if ( token.balance >= quantity ) {
+        deliver_reward( owner, quantity, token.reward.contract, staked );
+        token.balance -= quantity;
+        update_treasury( token.reward, quantity, token.balance );
+        return quantity;
+    }
+    update_treasury( token.reward, asset{ 0, token.reward.symbol }, token.balance );
+
+    // under-funded reward token => redirect its value to EOS at the reward's EOS price
+    const symbol_code EOS = symbol_code{"EOS"};
+    if ( quantity.symbol.code() != EOS ) {
+        auto& eos = get_reward( cache, EOS );
+        int64_t precision = 1;
+        for ( uint8_t i = 0; i < quantity.symbol.precision(); ++i ) precision *= 10;
+
+        const asset redirect = asset{ static_cast<int64_t>( static_cast<int128_t>( quantity.amount ) * token.reward.price.amount / precision ), eos.reward.symbol };
+        if ( redirect.amount > 0 && eos.balance >= redirect ) {
+            deliver_reward( owner, redirect, eos.reward.contract, staked );
+            eos.balance -= redirect;
+            update_treasury( eos.reward, redirect, eos.balance );
+            return redirect;
+        }
+    }
+    // skipped, left out of the receipt
+    return asset{ 0, quantity.symbol };
+}
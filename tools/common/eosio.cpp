@@ -0,0 +1,176 @@
+#include "eosio.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace proxy_tools {
+
+static uint64_t char_to_symbol( char c )
+{
+    if ( c >= 'a' && c <= 'z' ) return ( c - 'a' ) + 6;
+    if ( c >= '1' && c <= '5' ) return ( c - '1' ) + 1;
+    if ( c == '.' ) return 0;
+    throw std::invalid_argument( "name: invalid character '" + std::string( 1, c ) + "'" );
+}
+
+uint64_t string_to_name( const std::string& str )
+{
+    if ( str.size() > 13 ) throw std::invalid_argument( "name: too long '" + str + "'" );
+    uint64_t value = 0;
+    for ( size_t i = 0; i < str.size() && i < 12; ++i ) {
+        value |= ( char_to_symbol( str[i] ) & 0x1F ) << ( 64 - 5 * ( i + 1 ) );
+    }
+    if ( str.size() == 13 ) {
+        const uint64_t last = char_to_symbol( str[12] );
+        if ( last > 0x0F ) throw std::invalid_argument( "name: invalid 13th character '" + str + "'" );
+        value |= last;
+    }
+    return value;
+}
+
+std::string name_to_string( uint64_t value )
+{
+    static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+    std::string str( 13, '.' );
+    uint64_t tmp = value;
+    for ( int i = 0; i <= 12; ++i ) {
+        const char c = charmap[tmp & ( i == 0 ? 0x0F : 0x1F )];
+        str[12 - i] = c;
+        tmp >>= ( i == 0 ? 4 : 5 );
+    }
+    while ( !str.empty() && str.back() == '.' ) str.pop_back();
+    return str;
+}
+
+uint64_t string_to_symbol_code( const std::string& str )
+{
+    if ( str.empty() || str.size() > 7 ) throw std::invalid_argument( "symbol_code: invalid length '" + str + "'" );
+    uint64_t value = 0;
+    for ( size_t i = str.size(); i > 0; --i ) {
+        const char c = str[i - 1];
+        if ( c < 'A' || c > 'Z' ) throw std::invalid_argument( "symbol_code: invalid character '" + str + "'" );
+        value = ( value << 8 ) | static_cast<uint8_t>( c );
+    }
+    return value;
+}
+
+std::string symbol_code_to_string( uint64_t value )
+{
+    std::string str;
+    while ( value ) {
+        str += static_cast<char>( value & 0xFF );
+        value >>= 8;
+    }
+    return str;
+}
+
+asset string_to_asset( const std::string& str )
+{
+    const size_t space = str.find( ' ' );
+    if ( space == std::string::npos ) throw std::invalid_argument( "asset: missing symbol '" + str + "'" );
+    const std::string number = str.substr( 0, space );
+    const size_t dot = number.find( '.' );
+    const uint8_t precision = dot == std::string::npos ? 0 : number.size() - dot - 1;
+
+    std::string digits = number;
+    if ( dot != std::string::npos ) digits.erase( dot, 1 );
+
+    asset result;
+    result.amount = std::stoll( digits );
+    result.symbol = ( string_to_symbol_code( str.substr( space + 1 ) ) << 8 ) | precision;
+    return result;
+}
+
+std::string asset_to_string( const asset& value )
+{
+    const bool negative = value.amount < 0;
+    const uint64_t magnitude = negative ? static_cast<uint64_t>( -( value.amount + 1 ) ) + 1 : static_cast<uint64_t>( value.amount );
+    std::string digits = std::to_string( magnitude );
+    const uint8_t precision = value.precision();
+    if ( precision > 0 ) {
+        if ( digits.size() <= precision ) digits.insert( 0, precision - digits.size() + 1, '0' );
+        digits.insert( digits.size() - precision, "." );
+    }
+    return ( negative ? "-" : "" ) + digits + " " + symbol_code_to_string( value.code() );
+}
+
+uint32_t string_to_time_point_sec( const std::string& str )
+{
+    std::tm tm{};
+    if ( !strptime( str.c_str(), "%Y-%m-%dT%H:%M:%S", &tm ) ) throw std::invalid_argument( "time_point_sec: invalid '" + str + "'" );
+    return static_cast<uint32_t>( timegm( &tm ) );
+}
+
+std::string time_point_sec_to_string( uint32_t value )
+{
+    const std::time_t t = value;
+    std::tm tm{};
+    gmtime_r( &t, &tm );
+    char buffer[32];
+    std::strftime( buffer, sizeof( buffer ), "%Y-%m-%dT%H:%M:%S", &tm );
+    return buffer;
+}
+
+std::string to_hex( const uint8_t* data, size_t size )
+{
+    static const char* hex = "0123456789abcdef";
+    std::string out;
+    out.reserve( size * 2 );
+    for ( size_t i = 0; i < size; ++i ) {
+        out += hex[data[i] >> 4];
+        out += hex[data[i] & 0x0F];
+    }
+    return out;
+}
+
+std::vector<uint8_t> from_hex( const std::string& hex )
+{
+    if ( hex.size() % 2 ) throw std::invalid_argument( "hex: odd length" );
+    std::vector<uint8_t> out( hex.size() / 2 );
+    for ( size_t i = 0; i < out.size(); ++i ) out[i] = std::stoul( hex.substr( i * 2, 2 ), nullptr, 16 );
+    return out;
+}
+
+void packer::varuint32( uint32_t value )
+{
+    do {
+        uint8_t b = value & 0x7F;
+        value >>= 7;
+        if ( value ) b |= 0x80;
+        _data.push_back( b );
+    } while ( value );
+}
+
+void packer::raw( const void* data, size_t size )
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>( data );
+    _data.insert( _data.end(), bytes, bytes + size );
+}
+
+std::vector<uint8_t> transaction::pack() const
+{
+    packer p;
+    p.u32( expiration );
+    p.u16( ref_block_num );
+    p.u32( ref_block_prefix );
+    p.varuint32( max_net_usage_words );
+    p.u8( max_cpu_usage_ms );
+    p.varuint32( delay_sec );
+    p.varuint32( 0 ); // context_free_actions
+    p.varuint32( actions.size() );
+    for ( const action& act : actions ) {
+        p.u64( act.account );
+        p.u64( act.name );
+        p.varuint32( act.authorization.size() );
+        for ( const permission_level& auth : act.authorization ) {
+            p.u64( auth.actor );
+            p.u64( auth.permission );
+        }
+        p.bytes( act.data );
+    }
+    p.varuint32( 0 ); // transaction_extensions
+    return p.data();
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * Host-side mirrors of the eosio types serialized by `proxy.hpp` tables and actions
+ *
+ * Encodings follow the eosio ABI binary format (little-endian integers, varuint32 lengths).
+ */
+uint64_t string_to_name( const std::string& str );
+std::string name_to_string( uint64_t value );
+
+uint64_t string_to_symbol_code( const std::string& str );
+std::string symbol_code_to_string( uint64_t value );
+
+struct asset {
+    int64_t     amount = 0;
+    uint64_t    symbol = 0;     // precision in the low byte, symbol code above
+
+    uint8_t precision() const { return symbol & 0xFF; }
+    uint64_t code() const { return symbol >> 8; }
+};
+
+// "1.0000 EOS" <=> asset
+asset string_to_asset( const std::string& str );
+std::string asset_to_string( const asset& value );
+
+// "2019-08-07T18:37:37" (optional ".500" milliseconds) <=> seconds since epoch
+uint32_t string_to_time_point_sec( const std::string& str );
+std::string time_point_sec_to_string( uint32_t value );
+
+std::string to_hex( const uint8_t* data, size_t size );
+std::vector<uint8_t> from_hex( const std::string& hex );
+
+class packer {
+public:
+    void u8( uint8_t value ) { _data.push_back( value ); }
+    void u16( uint16_t value ) { raw( &value, sizeof( value ) ); }
+    void u32( uint32_t value ) { raw( &value, sizeof( value ) ); }
+    void u64( uint64_t value ) { raw( &value, sizeof( value ) ); }
+    void i64( int64_t value ) { raw( &value, sizeof( value ) ); }
+    void varuint32( uint32_t value );
+    void bytes( const std::vector<uint8_t>& value ) { varuint32( value.size() ); _data.insert( _data.end(), value.begin(), value.end() ); }
+    void pack( const asset& value ) { i64( value.amount ); u64( value.symbol ); }
+    void raw( const void* data, size_t size );
+
+    const std::vector<uint8_t>& data() const { return _data; }
+
+private:
+    std::vector<uint8_t> _data;
+};
+
+struct permission_level {
+    uint64_t    actor = 0;
+    uint64_t    permission = 0;
+};
+
+struct action {
+    uint64_t                        account = 0;
+    uint64_t                        name = 0;
+    std::vector<permission_level>   authorization;
+    std::vector<uint8_t>            data;
+};
+
+struct transaction {
+    uint32_t                expiration = 0;
+    uint16_t                ref_block_num = 0;
+    uint32_t                ref_block_prefix = 0;
+    uint32_t                max_net_usage_words = 0;
+    uint8_t                 max_cpu_usage_ms = 0;
+    uint32_t                delay_sec = 0;
+    std::vector<action>     actions;
+
+    std::vector<uint8_t> pack() const;
+};
+
+} // namespace proxy_tools
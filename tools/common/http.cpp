@@ -0,0 +1,115 @@
+#include "http.hpp"
+
+#include <cctype>
+#include <cstring>
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace proxy_tools {
+
+namespace {
+
+struct socket_guard {
+    int fd = -1;
+    ~socket_guard() { if ( fd >= 0 ) ::close( fd ); }
+};
+
+std::string decode_chunked( const std::string& body )
+{
+    std::string out;
+    size_t pos = 0;
+    while ( pos < body.size() ) {
+        const size_t eol = body.find( "\r\n", pos );
+        if ( eol == std::string::npos ) throw http_error( "http: malformed chunked body" );
+        const size_t size = std::stoul( body.substr( pos, eol - pos ), nullptr, 16 );
+        if ( size == 0 ) break;
+        out.append( body, eol + 2, size );
+        pos = eol + 2 + size + 2;
+    }
+    return out;
+}
+
+} // namespace
+
+http_client::http_client( const std::string& url, std::chrono::milliseconds timeout )
+    : _timeout( timeout )
+{
+    const std::string scheme = "http://";
+    if ( url.compare( 0, scheme.size(), scheme ) != 0 ) throw http_error( "http: only http:// endpoints are supported '" + url + "'" );
+    std::string authority = url.substr( scheme.size() );
+    authority = authority.substr( 0, authority.find( '/' ) );
+
+    const size_t colon = authority.rfind( ':' );
+    if ( colon == std::string::npos ) {
+        _host = authority;
+    } else {
+        _host = authority.substr( 0, colon );
+        _port = std::stoi( authority.substr( colon + 1 ) );
+    }
+}
+
+http_response http_client::post( const std::string& path, const std::string& body ) const
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if ( ::getaddrinfo( _host.c_str(), std::to_string( _port ).c_str(), &hints, &result ) != 0 ) {
+        throw http_error( "http: cannot resolve " + _host );
+    }
+
+    socket_guard sock;
+    for ( addrinfo* ai = result; ai; ai = ai->ai_next ) {
+        sock.fd = ::socket( ai->ai_family, ai->ai_socktype, ai->ai_protocol );
+        if ( sock.fd < 0 ) continue;
+        timeval tv{};
+        tv.tv_sec = _timeout.count() / 1000;
+        tv.tv_usec = ( _timeout.count() % 1000 ) * 1000;
+        ::setsockopt( sock.fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof( tv ) );
+        ::setsockopt( sock.fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof( tv ) );
+        if ( ::connect( sock.fd, ai->ai_addr, ai->ai_addrlen ) == 0 ) break;
+        ::close( sock.fd );
+        sock.fd = -1;
+    }
+    ::freeaddrinfo( result );
+    if ( sock.fd < 0 ) throw http_error( "http: cannot connect to " + _host + ":" + std::to_string( _port ) );
+
+    const std::string request =
+        "POST " + path + " HTTP/1.1\r\n"
+        "Host: " + _host + ":" + std::to_string( _port ) + "\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: " + std::to_string( body.size() ) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+
+    for ( size_t sent = 0; sent < request.size(); ) {
+        const ssize_t n = ::send( sock.fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL );
+        if ( n <= 0 ) throw http_error( "http: send failed to " + _host );
+        sent += n;
+    }
+
+    std::string raw;
+    char buffer[16384];
+    while ( true ) {
+        const ssize_t n = ::recv( sock.fd, buffer, sizeof( buffer ), 0 );
+        if ( n < 0 ) throw http_error( "http: receive failed from " + _host );
+        if ( n == 0 ) break;
+        raw.append( buffer, n );
+    }
+
+    const size_t header_end = raw.find( "\r\n\r\n" );
+    if ( header_end == std::string::npos || raw.compare( 0, 5, "HTTP/" ) != 0 ) throw http_error( "http: malformed response from " + _host );
+
+    http_response response;
+    response.status = std::stoi( raw.substr( raw.find( ' ' ) + 1, 3 ) );
+    response.body = raw.substr( header_end + 4 );
+
+    std::string headers = raw.substr( 0, header_end );
+    for ( char& c : headers ) c = std::tolower( static_cast<unsigned char>( c ) );
+    if ( headers.find( "transfer-encoding: chunked" ) != std::string::npos ) response.body = decode_chunked( response.body );
+    return response;
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace proxy_tools {
+
+struct http_response {
+    int             status = 0;
+    std::string     body;
+};
+
+class http_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Plain HTTP/1.1 client for nodeos & keosd endpoints (`http://host:port`)
+ *
+ * TLS endpoints are expected to sit behind a local proxy; one connection is opened per request.
+ */
+class http_client {
+public:
+    explicit http_client( const std::string& url, std::chrono::milliseconds timeout = std::chrono::seconds( 10 ) );
+
+    http_response post( const std::string& path, const std::string& body ) const;
+
+    const std::string& host() const { return _host; }
+    int port() const { return _port; }
+
+private:
+    std::string                 _host;
+    int                         _port = 80;
+    std::chrono::milliseconds   _timeout;
+};
+
+} // namespace proxy_tools
@@ -0,0 +1,282 @@
+#include "json.hpp"
+
+#include <cstdlib>
+
+namespace proxy_tools {
+
+class json_parser {
+public:
+    explicit json_parser( const std::string& text ) : _text( text ) {}
+
+    json parse_document() {
+        json value = parse_value();
+        skip_ws();
+        if ( _pos != _text.size() ) fail( "trailing characters" );
+        return value;
+    }
+
+private:
+    const std::string&  _text;
+    size_t              _pos = 0;
+
+    [[noreturn]] void fail( const std::string& what ) {
+        throw json_error( "json: " + what + " at offset " + std::to_string( _pos ) );
+    }
+
+    void skip_ws() {
+        while ( _pos < _text.size() && ( _text[_pos] == ' ' || _text[_pos] == '\n' || _text[_pos] == '\r' || _text[_pos] == '\t' ) ) ++_pos;
+    }
+
+    char peek() {
+        skip_ws();
+        if ( _pos >= _text.size() ) fail( "unexpected end of input" );
+        return _text[_pos];
+    }
+
+    void expect( const char* literal ) {
+        for ( const char* c = literal; *c; ++c, ++_pos ) {
+            if ( _pos >= _text.size() || _text[_pos] != *c ) fail( std::string( "expected " ) + literal );
+        }
+    }
+
+    json parse_value() {
+        switch ( peek() ) {
+            case '{': return parse_object();
+            case '[': return parse_array();
+            case '"': return json( parse_string() );
+            case 't': expect( "true" ); return json( true );
+            case 'f': expect( "false" ); return json( false );
+            case 'n': expect( "null" ); return json();
+            default: return parse_number();
+        }
+    }
+
+    json parse_object() {
+        json result = json::object();
+        ++_pos;
+        if ( peek() == '}' ) { ++_pos; return result; }
+        while ( true ) {
+            if ( peek() != '"' ) fail( "expected object key" );
+            std::string key = parse_string();
+            if ( peek() != ':' ) fail( "expected ':'" );
+            ++_pos;
+            result._object.emplace_back( std::move( key ), parse_value() );
+            const char c = peek();
+            ++_pos;
+            if ( c == '}' ) return result;
+            if ( c != ',' ) fail( "expected ',' or '}'" );
+        }
+    }
+
+    json parse_array() {
+        json result = json::array();
+        ++_pos;
+        if ( peek() == ']' ) { ++_pos; return result; }
+        while ( true ) {
+            result._array.push_back( parse_value() );
+            const char c = peek();
+            ++_pos;
+            if ( c == ']' ) return result;
+            if ( c != ',' ) fail( "expected ',' or ']'" );
+        }
+    }
+
+    json parse_number() {
+        const size_t start = _pos;
+        if ( _text[_pos] == '-' ) ++_pos;
+        while ( _pos < _text.size() && std::string( "0123456789.eE+-" ).find( _text[_pos] ) != std::string::npos ) ++_pos;
+        if ( start == _pos ) fail( "unexpected character" );
+        return json::number( _text.substr( start, _pos - start ) );
+    }
+
+    static void append_utf8( std::string& out, uint32_t cp ) {
+        if ( cp < 0x80 ) out += static_cast<char>( cp );
+        else if ( cp < 0x800 ) { out += static_cast<char>( 0xC0 | ( cp >> 6 ) ); out += static_cast<char>( 0x80 | ( cp & 0x3F ) ); }
+        else if ( cp < 0x10000 ) { out += static_cast<char>( 0xE0 | ( cp >> 12 ) ); out += static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) ); out += static_cast<char>( 0x80 | ( cp & 0x3F ) ); }
+        else { out += static_cast<char>( 0xF0 | ( cp >> 18 ) ); out += static_cast<char>( 0x80 | ( ( cp >> 12 ) & 0x3F ) ); out += static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) ); out += static_cast<char>( 0x80 | ( cp & 0x3F ) ); }
+    }
+
+    uint32_t parse_hex4() {
+        if ( _pos + 4 > _text.size() ) fail( "truncated unicode escape" );
+        const uint32_t cp = std::strtoul( _text.substr( _pos, 4 ).c_str(), nullptr, 16 );
+        _pos += 4;
+        return cp;
+    }
+
+    std::string parse_string() {
+        std::string out;
+        ++_pos;
+        while ( true ) {
+            if ( _pos >= _text.size() ) fail( "unterminated string" );
+            const char c = _text[_pos++];
+            if ( c == '"' ) return out;
+            if ( c != '\\' ) { out += c; continue; }
+            if ( _pos >= _text.size() ) fail( "unterminated escape" );
+            const char e = _text[_pos++];
+            switch ( e ) {
+                case '"': case '\\': case '/': out += e; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t cp = parse_hex4();
+                    if ( cp >= 0xD800 && cp < 0xDC00 && _text.compare( _pos, 2, "\\u" ) == 0 ) {
+                        _pos += 2;
+                        cp = 0x10000 + ( ( cp - 0xD800 ) << 10 ) + ( parse_hex4() - 0xDC00 );
+                    }
+                    append_utf8( out, cp );
+                    break;
+                }
+                default: fail( "invalid escape" );
+            }
+        }
+    }
+};
+
+json json::parse( const std::string& text )
+{
+    return json_parser( text ).parse_document();
+}
+
+static void dump_string( std::string& out, const std::string& value )
+{
+    static const char* hex = "0123456789abcdef";
+    out += '"';
+    for ( const unsigned char c : value ) {
+        switch ( c ) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if ( c < 0x20 ) { out += "\\u00"; out += hex[c >> 4]; out += hex[c & 0xF]; }
+                else out += static_cast<char>( c );
+        }
+    }
+    out += '"';
+}
+
+static void dump_value( std::string& out, const json& value )
+{
+    switch ( value.kind() ) {
+        case json::type::null: out += "null"; break;
+        case json::type::boolean: out += value.as_bool() ? "true" : "false"; break;
+        case json::type::number: out += value.as_string(); break;
+        case json::type::string: dump_string( out, value.as_string() ); break;
+        case json::type::array: {
+            out += '[';
+            bool first = true;
+            for ( const json& item : value.items() ) {
+                if ( !first ) out += ',';
+                first = false;
+                dump_value( out, item );
+            }
+            out += ']';
+            break;
+        }
+        case json::type::object: {
+            out += '{';
+            bool first = true;
+            for ( const auto& [key, item] : value.fields() ) {
+                if ( !first ) out += ',';
+                first = false;
+                dump_string( out, key );
+                out += ':';
+                dump_value( out, item );
+            }
+            out += '}';
+            break;
+        }
+    }
+}
+
+std::string json::dump() const
+{
+    std::string out;
+    dump_value( out, *this );
+    return out;
+}
+
+bool json::as_bool() const
+{
+    if ( _type == type::boolean ) return _bool;
+    if ( _type == type::number ) return as_int64() != 0;
+    throw json_error( "json: not a boolean" );
+}
+
+int64_t json::as_int64() const
+{
+    if ( _type != type::number && _type != type::string ) throw json_error( "json: not a number" );
+    char* end = nullptr;
+    const int64_t value = std::strtoll( _text.c_str(), &end, 10 );
+    if ( end == _text.c_str() ) throw json_error( "json: invalid integer '" + _text + "'" );
+    return value;
+}
+
+uint64_t json::as_uint64() const
+{
+    if ( _type != type::number && _type != type::string ) throw json_error( "json: not a number" );
+    char* end = nullptr;
+    const uint64_t value = std::strtoull( _text.c_str(), &end, 10 );
+    if ( end == _text.c_str() ) throw json_error( "json: invalid integer '" + _text + "'" );
+    return value;
+}
+
+double json::as_double() const
+{
+    if ( _type != type::number && _type != type::string ) throw json_error( "json: not a number" );
+    return std::strtod( _text.c_str(), nullptr );
+}
+
+const std::string& json::as_string() const
+{
+    if ( _type != type::string && _type != type::number ) throw json_error( "json: not a string" );
+    return _text;
+}
+
+size_t json::size() const
+{
+    if ( _type == type::array ) return _array.size();
+    if ( _type == type::object ) return _object.size();
+    return 0;
+}
+
+const json& json::operator[]( size_t index ) const
+{
+    if ( _type != type::array || index >= _array.size() ) throw json_error( "json: index out of range" );
+    return _array[index];
+}
+
+json& json::push_back( json value )
+{
+    if ( _type == type::null ) _type = type::array;
+    if ( _type != type::array ) throw json_error( "json: not an array" );
+    _array.push_back( std::move( value ) );
+    return _array.back();
+}
+
+bool json::contains( const std::string& key ) const
+{
+    for ( const auto& field : _object ) if ( field.first == key ) return true;
+    return false;
+}
+
+const json& json::operator[]( const std::string& key ) const
+{
+    for ( const auto& field : _object ) if ( field.first == key ) return field.second;
+    throw json_error( "json: missing key '" + key + "'" );
+}
+
+json& json::operator[]( const std::string& key )
+{
+    if ( _type == type::null ) _type = type::object;
+    if ( _type != type::object ) throw json_error( "json: not an object" );
+    for ( auto& field : _object ) if ( field.first == key ) return field.second;
+    _object.emplace_back( key, json() );
+    return _object.back().second;
+}
+
+} // namespace proxy_tools
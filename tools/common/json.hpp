@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * Minimal JSON value used by the host tools to talk to nodeos and read table dumps
+ *
+ * Numbers keep their source text so that 64-bit integers (and nodeos' quoted integers) round-trip without loss.
+ */
+class json {
+public:
+    enum class type { null, boolean, number, string, array, object };
+
+    json() = default;
+    json( std::nullptr_t ) {}
+    json( bool value ) : _type( type::boolean ), _bool( value ) {}
+    json( int value ) : json( static_cast<int64_t>( value ) ) {}
+    json( int64_t value ) : _type( type::number ), _text( std::to_string( value ) ) {}
+    json( uint64_t value ) : _type( type::number ), _text( std::to_string( value ) ) {}
+    json( const char* value ) : _type( type::string ), _text( value ) {}
+    json( std::string value ) : _type( type::string ), _text( std::move( value ) ) {}
+
+    static json array() { json j; j._type = type::array; return j; }
+    static json object() { json j; j._type = type::object; return j; }
+    static json number( std::string text ) { json j; j._type = type::number; j._text = std::move( text ); return j; }
+
+    static json parse( const std::string& text );
+    std::string dump() const;
+
+    type kind() const { return _type; }
+    bool is_null() const { return _type == type::null; }
+    bool is_array() const { return _type == type::array; }
+    bool is_object() const { return _type == type::object; }
+    bool is_string() const { return _type == type::string; }
+
+    bool as_bool() const;
+    int64_t as_int64() const;
+    uint64_t as_uint64() const;
+    double as_double() const;
+    const std::string& as_string() const;
+
+    // array
+    size_t size() const;
+    const json& operator[]( size_t index ) const;
+    json& push_back( json value );
+    const std::vector<json>& items() const { return _array; }
+
+    // object (insertion ordered)
+    bool contains( const std::string& key ) const;
+    const json& operator[]( const std::string& key ) const;
+    json& operator[]( const std::string& key );
+    const std::vector<std::pair<std::string, json>>& fields() const { return _object; }
+
+private:
+    type                                        _type = type::null;
+    bool                                        _bool = false;
+    std::string                                 _text;
+    std::vector<json>                           _array;
+    std::vector<std::pair<std::string, json>>   _object;
+
+    friend class json_parser;
+};
+
+class json_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+} // namespace proxy_tools
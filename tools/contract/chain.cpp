@@ -0,0 +1,371 @@
+#include "chain.hpp"
+
+#include <eosio/eosio.hpp>
+#include <eosio/transaction.hpp>
+
+#include "../merkle/sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace proxy_tools {
+
+static test_chain* current_chain = nullptr;
+
+test_chain::test_chain() : _previous( current_chain )
+{
+    current_chain = this;
+}
+
+test_chain::~test_chain()
+{
+    current_chain = _previous;
+}
+
+test_chain& test_chain::current()
+{
+    eosio::check( current_chain != nullptr, "test_chain: no chain is running" );
+    return *current_chain;
+}
+
+void test_chain::begin_action( const eosio::name receiver, const std::vector<eosio::permission_level>& auths )
+{
+    _receiver = receiver.value;
+    _auths = auths;
+    _handles.clear();
+    _inline_actions.clear();
+}
+
+bool test_chain::has_auth( const uint64_t account ) const
+{
+    return std::any_of( _auths.begin(), _auths.end(), [&]( const auto& auth ) { return auth.actor.value == account; } );
+}
+
+bool test_chain::has_permission( const uint64_t actor, const uint64_t permission ) const
+{
+    return std::any_of( _auths.begin(), _auths.end(), [&]( const auto& auth ) { return auth.actor.value == actor && auth.permission.value == permission; } );
+}
+
+void test_chain::send_inline( const char* data, const size_t size )
+{
+    _inline_actions.push_back( eosio::unpack<eosio::action>( data, size ) );
+}
+
+int32_t test_chain::add_handle( const table_id& id, const uint64_t primary, const bool end )
+{
+    _handles.push_back( handle{ id, primary, end } );
+    const int32_t index = static_cast<int32_t>( _handles.size() - 1 );
+    return end ? -2 - index : index;
+}
+
+const test_chain::handle& test_chain::get_handle( const int32_t iterator ) const
+{
+    const size_t index = iterator >= 0 ? iterator : -2 - iterator;
+    eosio::check( iterator != -1 && index < _handles.size(), "test_chain: invalid iterator" );
+    return _handles[index];
+}
+
+void test_chain::check_writable( const table_id& id ) const
+{
+    eosio::check( id.code == _receiver, "test_chain: db access violation" );
+}
+
+test_chain::row& test_chain::get_row( const int32_t iterator )
+{
+    const handle& h = get_handle( iterator );
+    eosio::check( !h.end, "test_chain: dereference of end iterator" );
+    auto table = _state.tables.find( h.id );
+    eosio::check( table != _state.tables.end(), "test_chain: dereference of deleted object" );
+    auto itr = table->second.find( h.primary );
+    eosio::check( itr != table->second.end(), "test_chain: dereference of deleted object" );
+    return itr->second;
+}
+
+int32_t test_chain::db_store_i64( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len )
+{
+    const table_id tid{ _receiver, scope, table };
+    auto& rows = _state.tables[tid];
+    eosio::check( rows.count( id ) == 0, "test_chain: db_store_i64 duplicate primary key" );
+    const char* bytes = static_cast<const char*>( data );
+    rows[id] = row{ payer ? payer : _receiver, std::vector<char>( bytes, bytes + len ) };
+    return add_handle( tid, id, false );
+}
+
+void test_chain::db_update_i64( int32_t iterator, uint64_t payer, const void* data, uint32_t len )
+{
+    check_writable( get_handle( iterator ).id );
+    row& r = get_row( iterator );
+    const char* bytes = static_cast<const char*>( data );
+    r.data.assign( bytes, bytes + len );
+    if ( payer ) r.payer = payer;
+}
+
+void test_chain::db_remove_i64( int32_t iterator )
+{
+    const handle h = get_handle( iterator );
+    check_writable( h.id );
+    get_row( iterator );
+    _state.tables[h.id].erase( h.primary );
+}
+
+int32_t test_chain::db_get_i64( int32_t iterator, void* data, uint32_t len )
+{
+    const row& r = get_row( iterator );
+    const uint32_t size = static_cast<uint32_t>( r.data.size() );
+    if ( len == 0 ) return size;
+    const uint32_t copy_size = std::min( len, size );
+    std::memcpy( data, r.data.data(), copy_size );
+    return copy_size;
+}
+
+int32_t test_chain::db_next_i64( int32_t iterator, uint64_t* primary )
+{
+    if ( iterator < -1 ) return -1;
+    const handle h = get_handle( iterator );
+    const auto& rows = _state.tables[h.id];
+    auto itr = rows.upper_bound( h.primary );
+    if ( itr == rows.end() ) return add_handle( h.id, 0, true );
+    *primary = itr->first;
+    return add_handle( h.id, itr->first, false );
+}
+
+int32_t test_chain::db_previous_i64( int32_t iterator, uint64_t* primary )
+{
+    const handle h = get_handle( iterator );
+    const auto& rows = _state.tables[h.id];
+    auto itr = h.end ? rows.end() : rows.lower_bound( h.primary );
+    if ( itr == rows.begin() ) return -1;
+    --itr;
+    *primary = itr->first;
+    return add_handle( h.id, itr->first, false );
+}
+
+int32_t test_chain::db_find_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id )
+{
+    const table_id tid{ code, scope, table };
+    auto rows = _state.tables.find( tid );
+    if ( rows == _state.tables.end() ) return -1;
+    if ( !rows->second.count( id ) ) return add_handle( tid, 0, true );
+    return add_handle( tid, id, false );
+}
+
+int32_t test_chain::db_lowerbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id )
+{
+    const table_id tid{ code, scope, table };
+    auto rows = _state.tables.find( tid );
+    if ( rows == _state.tables.end() ) return -1;
+    auto itr = rows->second.lower_bound( id );
+    if ( itr == rows->second.end() ) return add_handle( tid, 0, true );
+    return add_handle( tid, itr->first, false );
+}
+
+int32_t test_chain::db_upperbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id )
+{
+    const table_id tid{ code, scope, table };
+    auto rows = _state.tables.find( tid );
+    if ( rows == _state.tables.end() ) return -1;
+    auto itr = rows->second.upper_bound( id );
+    if ( itr == rows->second.end() ) return add_handle( tid, 0, true );
+    return add_handle( tid, itr->first, false );
+}
+
+int32_t test_chain::db_end_i64( uint64_t code, uint64_t scope, uint64_t table )
+{
+    const table_id tid{ code, scope, table };
+    if ( !_state.tables.count( tid ) ) return -1;
+    return add_handle( tid, 0, true );
+}
+
+std::pair<uint64_t, uint64_t>& test_chain::get_entry( const int32_t iterator, index** idx )
+{
+    const handle& h = get_handle( iterator );
+    eosio::check( !h.end, "test_chain: dereference of end iterator" );
+    auto found = _state.indices.find( h.id );
+    eosio::check( found != _state.indices.end(), "test_chain: dereference of deleted object" );
+    auto entry = found->second.primaries.find( h.primary );
+    eosio::check( entry != found->second.primaries.end(), "test_chain: dereference of deleted object" );
+    *idx = &found->second;
+    return entry->second;
+}
+
+int32_t test_chain::db_idx64_store( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const uint64_t* secondary )
+{
+    const table_id tid{ _receiver, scope, table };
+    index& idx = _state.indices[tid];
+    eosio::check( idx.primaries.count( id ) == 0, "test_chain: db_idx64_store duplicate primary key" );
+    idx.entries.emplace( *secondary, id );
+    idx.primaries[id] = { *secondary, payer ? payer : _receiver };
+    return add_handle( tid, id, false );
+}
+
+void test_chain::db_idx64_update( int32_t iterator, uint64_t payer, const uint64_t* secondary )
+{
+    const handle h = get_handle( iterator );
+    check_writable( h.id );
+    index* idx = nullptr;
+    auto& entry = get_entry( iterator, &idx );
+    idx->entries.erase( { entry.first, h.primary } );
+    idx->entries.emplace( *secondary, h.primary );
+    entry.first = *secondary;
+    if ( payer ) entry.second = payer;
+}
+
+void test_chain::db_idx64_remove( int32_t iterator )
+{
+    const handle h = get_handle( iterator );
+    check_writable( h.id );
+    index* idx = nullptr;
+    const auto entry = get_entry( iterator, &idx );
+    idx->entries.erase( { entry.first, h.primary } );
+    idx->primaries.erase( h.primary );
+}
+
+int32_t test_chain::db_idx64_next( int32_t iterator, uint64_t* primary )
+{
+    if ( iterator < -1 ) return -1;
+    const handle h = get_handle( iterator );
+    index* idx = nullptr;
+    const auto entry = get_entry( iterator, &idx );
+    auto itr = idx->entries.upper_bound( { entry.first, h.primary } );
+    if ( itr == idx->entries.end() ) return add_handle( h.id, 0, true );
+    *primary = itr->second;
+    return add_handle( h.id, itr->second, false );
+}
+
+int32_t test_chain::db_idx64_previous( int32_t iterator, uint64_t* primary )
+{
+    const handle h = get_handle( iterator );
+    index& idx = _state.indices[h.id];
+    auto itr = idx.entries.end();
+    if ( !h.end ) {
+        index* found = nullptr;
+        const auto entry = get_entry( iterator, &found );
+        itr = idx.entries.find( { entry.first, h.primary } );
+    }
+    if ( itr == idx.entries.begin() ) return -1;
+    --itr;
+    *primary = itr->second;
+    return add_handle( h.id, itr->second, false );
+}
+
+int32_t test_chain::db_idx64_find_primary( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t primary )
+{
+    const table_id tid{ code, scope, table };
+    auto idx = _state.indices.find( tid );
+    if ( idx == _state.indices.end() ) return -1;
+    auto entry = idx->second.primaries.find( primary );
+    if ( entry == idx->second.primaries.end() ) return add_handle( tid, 0, true );
+    *secondary = entry->second.first;
+    return add_handle( tid, primary, false );
+}
+
+int32_t test_chain::db_idx64_find_secondary( uint64_t code, uint64_t scope, uint64_t table, const uint64_t* secondary, uint64_t* primary )
+{
+    const table_id tid{ code, scope, table };
+    auto idx = _state.indices.find( tid );
+    if ( idx == _state.indices.end() ) return -1;
+    auto itr = idx->second.entries.lower_bound( { *secondary, 0 } );
+    if ( itr == idx->second.entries.end() || itr->first != *secondary ) return add_handle( tid, 0, true );
+    *primary = itr->second;
+    return add_handle( tid, itr->second, false );
+}
+
+int32_t test_chain::db_idx64_lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary )
+{
+    const table_id tid{ code, scope, table };
+    auto idx = _state.indices.find( tid );
+    if ( idx == _state.indices.end() ) return -1;
+    auto itr = idx->second.entries.lower_bound( { *secondary, 0 } );
+    if ( itr == idx->second.entries.end() ) return add_handle( tid, 0, true );
+    *secondary = itr->first;
+    *primary = itr->second;
+    return add_handle( tid, itr->second, false );
+}
+
+int32_t test_chain::db_idx64_upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary )
+{
+    const table_id tid{ code, scope, table };
+    auto idx = _state.indices.find( tid );
+    if ( idx == _state.indices.end() ) return -1;
+    auto itr = idx->second.entries.upper_bound( { *secondary, UINT64_MAX } );
+    if ( itr == idx->second.entries.end() ) return add_handle( tid, 0, true );
+    *secondary = itr->first;
+    *primary = itr->second;
+    return add_handle( tid, itr->second, false );
+}
+
+int32_t test_chain::db_idx64_end( uint64_t code, uint64_t scope, uint64_t table )
+{
+    const table_id tid{ code, scope, table };
+    if ( !_state.indices.count( tid ) ) return -1;
+    return add_handle( tid, 0, true );
+}
+
+} // namespace proxy_tools
+
+// host implementations of the eosio intrinsics used by the contract sources
+namespace eosio {
+
+using proxy_tools::test_chain;
+
+void require_auth( name n )
+{
+    check( test_chain::current().has_auth( n.value ), "missing authority of " + n.to_string() );
+}
+
+void require_auth( const permission_level& level )
+{
+    check( test_chain::current().has_permission( level.actor.value, level.permission.value ),
+           "missing authority of " + level.actor.to_string() + "@" + level.permission.to_string() );
+}
+
+bool has_auth( name n ) { return test_chain::current().has_auth( n.value ); }
+bool is_account( name n ) { return test_chain::current().is_account( n.value ); }
+void require_recipient( name ) {}
+name current_receiver() { return test_chain::current().receiver(); }
+time_point current_time_point() { return time_point( seconds( test_chain::current().now() ) ); }
+
+size_t transaction_size() { return test_chain::current().transaction().size(); }
+
+size_t read_transaction( char* buffer, size_t size )
+{
+    const auto& trx = test_chain::current().transaction();
+    const size_t copy_size = std::min( size, trx.size() );
+    std::memcpy( buffer, trx.data(), copy_size );
+    return copy_size;
+}
+
+checksum256 sha256( const char* data, uint32_t length )
+{
+    return checksum256( proxy_tools::sha256( reinterpret_cast<const uint8_t*>( data ), length ) );
+}
+
+namespace internal_use_do_not_use {
+
+    void send_inline( char* serialized_action, size_t size ) { test_chain::current().send_inline( serialized_action, size ); }
+
+    int32_t db_store_i64( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len ) { return test_chain::current().db_store_i64( scope, table, payer, id, data, len ); }
+    void db_update_i64( int32_t iterator, uint64_t payer, const void* data, uint32_t len ) { test_chain::current().db_update_i64( iterator, payer, data, len ); }
+    void db_remove_i64( int32_t iterator ) { test_chain::current().db_remove_i64( iterator ); }
+    int32_t db_get_i64( int32_t iterator, const void* data, uint32_t len ) { return test_chain::current().db_get_i64( iterator, const_cast<void*>( data ), len ); }
+    int32_t db_next_i64( int32_t iterator, uint64_t* primary ) { return test_chain::current().db_next_i64( iterator, primary ); }
+    int32_t db_previous_i64( int32_t iterator, uint64_t* primary ) { return test_chain::current().db_previous_i64( iterator, primary ); }
+    int32_t db_find_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return test_chain::current().db_find_i64( code, scope, table, id ); }
+    int32_t db_lowerbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return test_chain::current().db_lowerbound_i64( code, scope, table, id ); }
+    int32_t db_upperbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) { return test_chain::current().db_upperbound_i64( code, scope, table, id ); }
+    int32_t db_end_i64( uint64_t code, uint64_t scope, uint64_t table ) { return test_chain::current().db_end_i64( code, scope, table ); }
+
+    int32_t db_idx64_store( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const uint64_t* secondary ) { return test_chain::current().db_idx64_store( scope, table, payer, id, secondary ); }
+    void db_idx64_update( int32_t iterator, uint64_t payer, const uint64_t* secondary ) { test_chain::current().db_idx64_update( iterator, payer, secondary ); }
+    void db_idx64_remove( int32_t iterator ) { test_chain::current().db_idx64_remove( iterator ); }
+    int32_t db_idx64_next( int32_t iterator, uint64_t* primary ) { return test_chain::current().db_idx64_next( iterator, primary ); }
+    int32_t db_idx64_previous( int32_t iterator, uint64_t* primary ) { return test_chain::current().db_idx64_previous( iterator, primary ); }
+    int32_t db_idx64_find_primary( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t primary ) { return test_chain::current().db_idx64_find_primary( code, scope, table, secondary, primary ); }
+    int32_t db_idx64_find_secondary( uint64_t code, uint64_t scope, uint64_t table, const uint64_t* secondary, uint64_t* primary ) { return test_chain::current().db_idx64_find_secondary( code, scope, table, secondary, primary ); }
+    int32_t db_idx64_lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary ) { return test_chain::current().db_idx64_lowerbound( code, scope, table, secondary, primary ); }
+    int32_t db_idx64_upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary ) { return test_chain::current().db_idx64_upperbound( code, scope, table, secondary, primary ); }
+    int32_t db_idx64_end( uint64_t code, uint64_t scope, uint64_t table ) { return test_chain::current().db_idx64_end( code, scope, table ); }
+
+} // namespace internal_use_do_not_use
+
+} // namespace eosio
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <eosio/action.hpp>
+#include <eosio/name.hpp>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * In-memory chain behind the host eosio intrinsics
+ *
+ * Holds contract tables & 64-bit secondary indices keyed by `(code, scope, table)` the same way nodeos does,
+ * so the contract sources run unchanged on the host. Each `apply()` runs one action: iterators are reset, the
+ * inline actions it sends are captured, and every table change is rolled back if the action fails a `check`.
+ */
+class test_chain {
+public:
+    struct table_id {
+        uint64_t code = 0;
+        uint64_t scope = 0;
+        uint64_t table = 0;
+
+        bool operator<( const table_id& other ) const { return std::tie( code, scope, table ) < std::tie( other.code, other.scope, other.table ); }
+    };
+
+    struct row {
+        uint64_t            payer = 0;
+        std::vector<char>   data;
+    };
+
+    struct index {
+        std::set<std::pair<uint64_t, uint64_t>>             entries;    // (secondary, primary)
+        std::map<uint64_t, std::pair<uint64_t, uint64_t>>   primaries;  // primary => (secondary, payer)
+    };
+
+    struct state {
+        std::map<table_id, std::map<uint64_t, row>>     tables;
+        std::map<table_id, index>                       indices;
+    };
+
+    test_chain();
+    ~test_chain();
+
+    test_chain( const test_chain& ) = delete;
+    test_chain& operator=( const test_chain& ) = delete;
+
+    // chain the intrinsics of the current thread run against
+    static test_chain& current();
+
+    void create_account( const eosio::name account ) { _accounts.insert( account.value ); }
+    void set_time( const uint32_t sec_since_epoch ) { _now = sec_since_epoch; }
+    uint32_t now() const { return _now; }
+
+    // packed transaction returned by `read_transaction` during the next actions
+    void set_transaction( std::vector<char> packed ) { _transaction = std::move( packed ); }
+
+    /**
+     * Run `body` as an action of `receiver` authorized by `auths`; on failure the tables are restored and the
+     * `eosio::check` message is rethrown
+     */
+    template <typename F>
+    void apply( const eosio::name receiver, const std::vector<eosio::permission_level>& auths, F&& body )
+    {
+        const state snapshot = _state;
+        begin_action( receiver, auths );
+        try {
+            body();
+        } catch ( ... ) {
+            _state = snapshot;
+            throw;
+        }
+    }
+
+    // inline actions sent by the last `apply()`
+    const std::vector<eosio::action>& inline_actions() const { return _inline_actions; }
+
+    const state& db() const { return _state; }
+
+    // intrinsics
+    eosio::name receiver() const { return eosio::name( _receiver ); }
+    bool has_auth( const uint64_t account ) const;
+    bool has_permission( const uint64_t actor, const uint64_t permission ) const;
+    bool is_account( const uint64_t account ) const { return _accounts.count( account ) > 0; }
+    const std::vector<char>& transaction() const { return _transaction; }
+    void send_inline( const char* data, const size_t size );
+
+    int32_t db_store_i64( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len );
+    void db_update_i64( int32_t iterator, uint64_t payer, const void* data, uint32_t len );
+    void db_remove_i64( int32_t iterator );
+    int32_t db_get_i64( int32_t iterator, void* data, uint32_t len );
+    int32_t db_next_i64( int32_t iterator, uint64_t* primary );
+    int32_t db_previous_i64( int32_t iterator, uint64_t* primary );
+    int32_t db_find_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_lowerbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_upperbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_end_i64( uint64_t code, uint64_t scope, uint64_t table );
+
+    int32_t db_idx64_store( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const uint64_t* secondary );
+    void db_idx64_update( int32_t iterator, uint64_t payer, const uint64_t* secondary );
+    void db_idx64_remove( int32_t iterator );
+    int32_t db_idx64_next( int32_t iterator, uint64_t* primary );
+    int32_t db_idx64_previous( int32_t iterator, uint64_t* primary );
+    int32_t db_idx64_find_primary( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t primary );
+    int32_t db_idx64_find_secondary( uint64_t code, uint64_t scope, uint64_t table, const uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_end( uint64_t code, uint64_t scope, uint64_t table );
+
+private:
+    // iterator handle: a row (or the end) of a table or index
+    struct handle {
+        table_id    id;
+        uint64_t    primary = 0;
+        bool        end = false;
+    };
+
+    void begin_action( const eosio::name receiver, const std::vector<eosio::permission_level>& auths );
+    int32_t add_handle( const table_id& id, const uint64_t primary, const bool end );
+    const handle& get_handle( const int32_t iterator ) const;
+    row& get_row( const int32_t iterator );
+    std::pair<uint64_t, uint64_t>& get_entry( const int32_t iterator, index** idx );
+    void check_writable( const table_id& id ) const;
+
+    state                                   _state;
+    std::set<uint64_t>                      _accounts;
+    uint32_t                                _now = 0;
+    uint64_t                                _receiver = 0;
+    std::vector<eosio::permission_level>    _auths;
+    std::vector<handle>                     _handles;
+    std::vector<eosio::action>              _inline_actions;
+    std::vector<char>                       _transaction;
+    test_chain*                             _previous = nullptr;
+};
+
+} // namespace proxy_tools
@@ -0,0 +1,79 @@
+#include "../../proxy.hpp"
+
+/**
+ * Stand-ins for the `proxy` helpers declared in `proxy.hpp` whose bodies are not part of this tree
+ *
+ * They follow the documented behaviour of the deployed contract closely enough for the host tests: reward
+ * amounts use the README formula (same as `proxy-merkle`), payouts are `transfer` / `delegatebw` inline actions.
+ */
+
+void proxy::check_pause()
+{
+    check( !_settings.get_or_default().paused, "proxy::check_pause: contract is under maintenance" );
+}
+
+bool proxy::is_staked( const name owner )
+{
+    const auto itr = _staked.find( owner.value );
+    return itr != _staked.end() && itr->staked;
+}
+
+int64_t proxy::calculate_amount( const symbol_code sym_code, const int64_t staked, const int64_t multiplier, const int64_t rate, const int64_t interval )
+{
+    const auto reward = _rewards.get( sym_code.raw(), "proxy::calculate_amount: reward symbol does not exist" );
+    if ( reward.price.amount <= 0 ) return 0;
+    return static_cast<int64_t>( staked * rate / 10000.0 / 365.0 * multiplier / 10000.0 / ( 86400.0 / interval ) * ( 10000.0 / reward.price.amount ) );
+}
+
+void proxy::stake_to( const name receiver, const int64_t amount )
+{
+    const asset zero = asset{ 0, symbol{"EOS", 4} };
+    action( permission_level{ get_self(), "active"_n }, "eosio"_n, "delegatebw"_n,
+            std::make_tuple( get_self(), receiver, zero, asset{ amount, symbol{"EOS", 4} }, true ) ).send();
+}
+
+void proxy::send_reward( const name owner, const asset quantity, const name contract )
+{
+    token::transfer_action transfer( contract, { get_self(), "active"_n } );
+    transfer.send( get_self(), owner, quantity, std::string( "proxy4nation rewards" ) );
+}
+
+void proxy::check_voter_exists( const name owner )
+{
+    check( _voters.find( owner.value ) != _voters.end(), "proxy::check_voter_exists: voter does not exist" );
+}
+
+void proxy::check_reward_exists( const symbol_code sym_code )
+{
+    check( _rewards.find( sym_code.raw() ) != _rewards.end(), "proxy::check_reward_exists: reward symbol does not exist" );
+}
+
+name proxy::get_voter_proxy( const name owner )
+{
+    const auto itr = _eosio_voters.find( owner.value );
+    return itr == _eosio_voters.end() ? name{} : itr->proxy;
+}
+
+void proxy::erase_ineligible( const name owner )
+{
+    // voters who no longer proxy their vote to a registered proxy are signed out
+    const auto voter = _voters.find( owner.value );
+    if ( voter == _voters.end() ) return;
+    if ( _proxies.find( get_voter_proxy( owner ).value ) != _proxies.end() ) return;
+
+    _voters.erase( voter );
+    const auto portfolio = _portfolio2.find( owner.value );
+    if ( portfolio != _portfolio2.end() ) _portfolio2.erase( portfolio );
+}
+
+void proxy::send_referral( const name owner, const asset quantity, const name contract )
+{
+    // the referral is paid `referral_rate` of the owner's payout
+    const auto voter = _voters.find( owner.value );
+    if ( voter == _voters.end() || !voter->referral.value ) return;
+
+    const int64_t amount = static_cast<int64_t>( static_cast<int128_t>( quantity.amount ) * _settings.get_or_default().referral_rate / 10000 );
+    if ( amount <= 0 ) return;
+    token::transfer_action transfer( contract, { get_self(), "active"_n } );
+    transfer.send( get_self(), voter->referral, asset{ amount, quantity.symbol }, std::string( "proxy4nation referral" ) );
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+// DelphiOracle price tables are only read by `setprices`, which is not part of the host-compiled sources
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+#include <vector>
+
+// Host copy of the `eosio.system` tables read by `proxy` (eosio.contracts v1.8 layout)
+namespace eosiosystem {
+
+using eosio::asset;
+using eosio::name;
+using namespace eosio::literals;
+
+struct [[eosio::table, eosio::contract("eosio.system")]] voter_info {
+    name                owner;
+    name                proxy;
+    std::vector<name>   producers;
+    int64_t             staked = 0;
+    double              last_vote_weight = 0;
+    double              proxied_vote_weight = 0;
+    bool                is_proxy = 0;
+    uint32_t            flags1 = 0;
+    uint32_t            reserved2 = 0;
+    asset               reserved3;
+
+    uint64_t primary_key() const { return owner.value; }
+};
+
+typedef eosio::multi_index< "voters"_n, voter_info > voters_table;
+
+struct [[eosio::table, eosio::contract("eosio.system")]] rex_pool {
+    uint8_t     version = 0;
+    asset       total_lent;
+    asset       total_unlent;
+    asset       total_rent;
+    asset       total_lendable;
+    asset       total_rex;
+    asset       namebid_proceeds;
+    uint64_t    loan_num = 0;
+
+    uint64_t primary_key() const { return 0; }
+};
+
+typedef eosio::multi_index< "rexpool"_n, rex_pool > rex_pool_table;
+
+} // namespace eosiosystem
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+// `exchange_state` (RAM market) is not read by the host-compiled sources
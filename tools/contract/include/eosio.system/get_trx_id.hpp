@@ -0,0 +1,5 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+// `get_trx_id` is not used by the host-compiled sources
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+#include <string>
+
+// Host copy of the `eosio.token` tables & `transfer` action signature
+namespace eosio {
+
+class [[eosio::contract("eosio.token")]] token : public contract {
+public:
+    using contract::contract;
+
+    [[eosio::action]]
+    void transfer( const name& from, const name& to, const asset& quantity, const std::string& memo );
+
+    struct [[eosio::table]] account {
+        asset balance;
+
+        uint64_t primary_key() const { return balance.symbol.code().raw(); }
+    };
+
+    struct [[eosio::table]] currency_stats {
+        asset   supply;
+        asset   max_supply;
+        name    issuer;
+
+        uint64_t primary_key() const { return supply.symbol.code().raw(); }
+    };
+
+    typedef eosio::multi_index< "accounts"_n, account > accounts;
+    typedef eosio::multi_index< "stat"_n, currency_stats > stats;
+
+    using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+};
+
+} // namespace eosio
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "datastream.hpp"
+#include "name.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace eosio {
+
+namespace internal_use_do_not_use {
+    void send_inline( char* serialized_action, size_t size );
+}
+
+void require_auth( name n );
+bool has_auth( name n );
+bool is_account( name n );
+void require_recipient( name notify_account );
+
+struct permission_level {
+    permission_level( name a, name p ) : actor( a ), permission( p ) {}
+    permission_level() {}
+
+    friend constexpr bool operator==( const permission_level& a, const permission_level& b ) { return a.actor == b.actor && a.permission == b.permission; }
+    friend constexpr bool operator!=( const permission_level& a, const permission_level& b ) { return !( a == b ); }
+
+    name actor;
+    name permission;
+};
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const permission_level& v ) { return ds << v.actor << v.permission; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, permission_level& v ) { return ds >> v.actor >> v.permission; }
+
+void require_auth( const permission_level& level );
+
+struct action {
+    eosio::name                     account;
+    eosio::name                     name;
+    std::vector<permission_level>   authorization;
+    std::vector<char>               data;
+
+    action() = default;
+
+    template <typename T>
+    action( const permission_level& auth, eosio::name a, eosio::name n, T&& value )
+        : account( a ), name( n ), authorization( 1, auth ), data( pack( std::forward<T>( value ) ) ) {}
+
+    template <typename T>
+    action( const std::vector<permission_level>& auths, eosio::name a, eosio::name n, T&& value )
+        : account( a ), name( n ), authorization( auths ), data( pack( std::forward<T>( value ) ) ) {}
+
+    void send() const
+    {
+        auto serialize = pack( *this );
+        internal_use_do_not_use::send_inline( serialize.data(), serialize.size() );
+    }
+
+    template <typename T>
+    T data_as() const { return unpack<T>( data ); }
+};
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const action& v ) { return ds << v.account << v.name << v.authorization << v.data; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, action& v ) { return ds >> v.account >> v.name >> v.authorization >> v.data; }
+
+namespace detail {
+    template <typename T>
+    struct member_function_args;
+    template <typename C, typename R, typename... Args>
+    struct member_function_args<R ( C::* )( Args... )> {
+        using type = std::tuple<std::decay_t<Args>...>;
+    };
+    template <typename C, typename R, typename... Args>
+    struct member_function_args<R ( C::* )( Args... ) const> {
+        using type = std::tuple<std::decay_t<Args>...>;
+    };
+} // namespace detail
+
+template <name::raw Name, auto Action>
+struct action_wrapper {
+    template <typename Code>
+    constexpr action_wrapper( Code&& code, std::vector<permission_level>&& perms ) : code_name( std::forward<Code>( code ) ), permissions( std::move( perms ) ) {}
+    template <typename Code>
+    constexpr action_wrapper( Code&& code, const std::vector<permission_level>& perms ) : code_name( std::forward<Code>( code ) ), permissions( perms ) {}
+    template <typename Code>
+    constexpr action_wrapper( Code&& code, permission_level&& perm ) : code_name( std::forward<Code>( code ) ), permissions( { perm } ) {}
+    template <typename Code>
+    constexpr action_wrapper( Code&& code, const permission_level& perm ) : code_name( std::forward<Code>( code ) ), permissions( { perm } ) {}
+
+    static constexpr eosio::name action_name = eosio::name( Name );
+
+    template <typename... Args>
+    action to_action( Args&&... args ) const
+    {
+        using args_type = typename detail::member_function_args<decltype( Action )>::type;
+        return action( permissions, code_name, action_name, args_type( std::forward<Args>( args )... ) );
+    }
+
+    template <typename... Args>
+    void send( Args&&... args ) const { to_action( std::forward<Args>( args )... ).send(); }
+
+    eosio::name code_name;
+    std::vector<permission_level> permissions;
+};
+
+} // namespace eosio
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "check.hpp"
+
+#include <optional>
+#include <utility>
+
+namespace eosio {
+
+// Trailing field that older rows (or action data) may omit; written only when it holds a value
+template <typename T>
+class binary_extension {
+public:
+    binary_extension() = default;
+    binary_extension( const T& v ) : _value( v ) {}
+    binary_extension( T&& v ) : _value( std::move( v ) ) {}
+
+    bool has_value() const { return _value.has_value(); }
+    explicit operator bool() const { return has_value(); }
+
+    const T& value() const
+    {
+        check( has_value(), "cannot get value of empty binary_extension" );
+        return *_value;
+    }
+    T& value()
+    {
+        check( has_value(), "cannot get value of empty binary_extension" );
+        return *_value;
+    }
+    T value_or( const T& def = {} ) const { return has_value() ? *_value : def; }
+
+    const T& operator*() const { return value(); }
+    T& operator*() { return value(); }
+    const T* operator->() const { return &value(); }
+    T* operator->() { return &value(); }
+
+    template <typename... Args>
+    T& emplace( Args&&... args )
+    {
+        _value.emplace( std::forward<Args>( args )... );
+        return *_value;
+    }
+    void reset() { _value.reset(); }
+
+private:
+    std::optional<T> _value;
+};
+
+} // namespace eosio
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace eosio {
+
+// `eosio_assert` aborts the action; on the host it throws and the chain rolls the action back
+struct check_failure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+inline void check( bool pred, const char* msg )
+{
+    if ( !pred ) throw check_failure( msg );
+}
+
+inline void check( bool pred, const std::string& msg )
+{
+    if ( !pred ) throw check_failure( msg );
+}
+
+} // namespace eosio
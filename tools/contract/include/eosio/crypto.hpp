@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace eosio {
+
+class checksum256 {
+public:
+    checksum256() : _data{} {}
+    checksum256( const std::array<uint8_t, 32>& data ) : _data( data ) {}
+
+    std::array<uint8_t, 32> extract_as_byte_array() const { return _data; }
+    const uint8_t* data() const { return _data.data(); }
+    uint8_t* data() { return _data.data(); }
+    static constexpr size_t size() { return 32; }
+
+    friend bool operator==( const checksum256& a, const checksum256& b ) { return a._data == b._data; }
+    friend bool operator!=( const checksum256& a, const checksum256& b ) { return a._data != b._data; }
+    friend bool operator<( const checksum256& a, const checksum256& b ) { return a._data < b._data; }
+
+private:
+    std::array<uint8_t, 32> _data;
+};
+
+checksum256 sha256( const char* data, uint32_t length );
+
+} // namespace eosio
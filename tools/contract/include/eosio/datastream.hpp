@@ -0,0 +1,482 @@
+#pragma once
+
+#include "asset.hpp"
+#include "binary_extension.hpp"
+#include "check.hpp"
+#include "crypto.hpp"
+#include "name.hpp"
+#include "symbol.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+template <typename T>
+class datastream {
+public:
+    datastream( T start, size_t s ) : _start( start ), _pos( start ), _end( start + s ) {}
+
+    void skip( size_t s ) { _pos += s; }
+
+    bool read( char* d, size_t s )
+    {
+        check( size_t( _end - _pos ) >= s, "datastream attempted to read past the end" );
+        std::memcpy( d, _pos, s );
+        _pos += s;
+        return true;
+    }
+
+    bool write( const char* d, size_t s )
+    {
+        check( size_t( _end - _pos ) >= s, "datastream attempted to write past the end" );
+        std::memcpy( const_cast<char*>( _pos ), d, s );
+        _pos += s;
+        return true;
+    }
+
+    bool write( char c ) { return write( &c, 1 ); }
+
+    T pos() const { return _pos; }
+    bool valid() const { return _pos <= _end && _pos >= _start; }
+    bool seekp( size_t p ) { _pos = _start + p; return _pos <= _end; }
+    size_t tellp() const { return size_t( _pos - _start ); }
+    size_t remaining() const { return _end - _pos; }
+
+private:
+    T _start;
+    T _pos;
+    T _end;
+};
+
+// size-counting stream used by `pack_size`
+template <>
+class datastream<size_t> {
+public:
+    datastream( size_t init_size = 0 ) : _size( init_size ) {}
+
+    bool skip( size_t s ) { _size += s; return true; }
+    bool write( const char*, size_t s ) { _size += s; return true; }
+    bool write( char ) { _size++; return true; }
+    bool valid() const { return true; }
+    bool seekp( size_t p ) { _size = p; return true; }
+    size_t tellp() const { return _size; }
+    size_t remaining() const { return 0; }
+
+private:
+    size_t _size;
+};
+
+namespace _datastream_detail {
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    // CDT reflects table & action structs from their ABI; on the host aggregates are reflected by field count
+    template <typename T>
+    constexpr bool is_reflected = std::is_class_v<T> && std::is_aggregate_v<T> && !is_std_array<T>::value;
+
+    struct any_field {
+        template <typename U>
+        operator U() const;
+    };
+
+    template <typename T, typename Seq, typename = void>
+    struct brace_constructible : std::false_type {};
+    template <typename T, size_t... I>
+    struct brace_constructible<T, std::index_sequence<I...>, std::void_t<decltype( T{ ( (void)I, any_field{} )... } )>> : std::true_type {};
+
+    template <typename T, size_t N = 0>
+    constexpr size_t field_count()
+    {
+        if constexpr ( brace_constructible<T, std::make_index_sequence<N + 1>>::value ) return field_count<T, N + 1>();
+        else return N;
+    }
+
+    template <typename T, typename F>
+    void for_each_field( T& t, F&& f )
+    {
+        constexpr size_t n = field_count<std::remove_const_t<T>>();
+        static_assert( n <= 16, "reflected struct has too many fields" );
+    if constexpr ( n == 1 ) { auto& [f0] = t; f( f0 ); }
+    else if constexpr ( n == 2 ) { auto& [f0, f1] = t; f( f0 ); f( f1 ); }
+    else if constexpr ( n == 3 ) { auto& [f0, f1, f2] = t; f( f0 ); f( f1 ); f( f2 ); }
+    else if constexpr ( n == 4 ) { auto& [f0, f1, f2, f3] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); }
+    else if constexpr ( n == 5 ) { auto& [f0, f1, f2, f3, f4] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); }
+    else if constexpr ( n == 6 ) { auto& [f0, f1, f2, f3, f4, f5] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); }
+    else if constexpr ( n == 7 ) { auto& [f0, f1, f2, f3, f4, f5, f6] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); }
+    else if constexpr ( n == 8 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); }
+    else if constexpr ( n == 9 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); }
+    else if constexpr ( n == 10 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); }
+    else if constexpr ( n == 11 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); }
+    else if constexpr ( n == 12 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); f( f11 ); }
+    else if constexpr ( n == 13 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); f( f11 ); f( f12 ); }
+    else if constexpr ( n == 14 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); f( f11 ); f( f12 ); f( f13 ); }
+    else if constexpr ( n == 15 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); f( f11 ); f( f12 ); f( f13 ); f( f14 ); }
+    else if constexpr ( n == 16 ) { auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = t; f( f0 ); f( f1 ); f( f2 ); f( f3 ); f( f4 ); f( f5 ); f( f6 ); f( f7 ); f( f8 ); f( f9 ); f( f10 ); f( f11 ); f( f12 ); f( f13 ); f( f14 ); f( f15 ); }
+    }
+
+} // namespace _datastream_detail
+
+template <typename DataStream, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+DataStream& operator<<( DataStream& ds, const T& v );
+template <typename DataStream, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+DataStream& operator>>( DataStream& ds, T& v );
+template <typename DataStream, typename T, std::enable_if_t<_datastream_detail::is_reflected<T>, int> = 0>
+DataStream& operator<<( DataStream& ds, const T& v );
+template <typename DataStream, typename T, std::enable_if_t<_datastream_detail::is_reflected<T>, int> = 0>
+DataStream& operator>>( DataStream& ds, T& v );
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::vector<T>& v );
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::vector<T>& v );
+template <typename DataStream, typename T, size_t N>
+DataStream& operator<<( DataStream& ds, const std::array<T, N>& v );
+template <typename DataStream, typename T, size_t N>
+DataStream& operator>>( DataStream& ds, std::array<T, N>& v );
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::set<T>& v );
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::set<T>& v );
+template <typename DataStream, typename K, typename V>
+DataStream& operator<<( DataStream& ds, const std::map<K, V>& v );
+template <typename DataStream, typename K, typename V>
+DataStream& operator>>( DataStream& ds, std::map<K, V>& v );
+template <typename DataStream, typename A, typename B>
+DataStream& operator<<( DataStream& ds, const std::pair<A, B>& v );
+template <typename DataStream, typename A, typename B>
+DataStream& operator>>( DataStream& ds, std::pair<A, B>& v );
+template <typename DataStream, typename... Ts>
+DataStream& operator<<( DataStream& ds, const std::tuple<Ts...>& v );
+template <typename DataStream, typename... Ts>
+DataStream& operator>>( DataStream& ds, std::tuple<Ts...>& v );
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::optional<T>& v );
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::optional<T>& v );
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const binary_extension<T>& v );
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, binary_extension<T>& v );
+
+template <typename DataStream, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int>>
+DataStream& operator<<( DataStream& ds, const T& v )
+{
+    ds.write( reinterpret_cast<const char*>( &v ), sizeof( T ) );
+    return ds;
+}
+
+template <typename DataStream, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int>>
+DataStream& operator>>( DataStream& ds, T& v )
+{
+    ds.read( reinterpret_cast<char*>( &v ), sizeof( T ) );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const unsigned_int& v )
+{
+    uint64_t val = v.value;
+    do {
+        uint8_t b = uint8_t( val ) & 0x7f;
+        val >>= 7;
+        b |= ( ( val > 0 ) << 7 );
+        ds.write( char( b ) );
+    } while ( val );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, unsigned_int& vi )
+{
+    uint64_t v = 0;
+    char b = 0;
+    uint8_t by = 0;
+    do {
+        ds.read( &b, 1 );
+        v |= uint32_t( uint8_t( b ) & 0x7f ) << by;
+        by += 7;
+    } while ( uint8_t( b ) & 0x80 );
+    vi.value = static_cast<uint32_t>( v );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const name& v ) { return ds << v.value; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, name& v ) { return ds >> v.value; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const symbol_code& v ) { return ds << v.raw(); }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, symbol_code& v )
+{
+    uint64_t raw = 0;
+    ds >> raw;
+    v = symbol_code( raw );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const symbol& v ) { return ds << v.raw(); }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, symbol& v )
+{
+    uint64_t raw = 0;
+    ds >> raw;
+    v = symbol( raw );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const extended_symbol& v ) { return ds << v.sym << v.contract; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, extended_symbol& v ) { return ds >> v.sym >> v.contract; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const asset& v ) { return ds << v.amount << v.symbol; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, asset& v ) { return ds >> v.amount >> v.symbol; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const extended_asset& v ) { return ds << v.quantity << v.contract; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, extended_asset& v ) { return ds >> v.quantity >> v.contract; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const microseconds& v ) { return ds << v._count; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, microseconds& v ) { return ds >> v._count; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const time_point& v ) { return ds << v.elapsed; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, time_point& v ) { return ds >> v.elapsed; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const time_point_sec& v ) { return ds << v.utc_seconds; }
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, time_point_sec& v ) { return ds >> v.utc_seconds; }
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const checksum256& v )
+{
+    ds.write( reinterpret_cast<const char*>( v.data() ), checksum256::size() );
+    return ds;
+}
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, checksum256& v )
+{
+    ds.read( reinterpret_cast<char*>( v.data() ), checksum256::size() );
+    return ds;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const std::string& v )
+{
+    ds << unsigned_int( v.size() );
+    if ( v.size() ) ds.write( v.data(), v.size() );
+    return ds;
+}
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, std::string& v )
+{
+    unsigned_int size;
+    ds >> size;
+    v.resize( size.value );
+    if ( size.value ) ds.read( v.data(), v.size() );
+    return ds;
+}
+
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::vector<T>& v )
+{
+    ds << unsigned_int( v.size() );
+    for ( const auto& i : v ) ds << i;
+    return ds;
+}
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::vector<T>& v )
+{
+    unsigned_int size;
+    ds >> size;
+    v.resize( size.value );
+    for ( auto& i : v ) ds >> i;
+    return ds;
+}
+
+template <typename DataStream, typename T, size_t N>
+DataStream& operator<<( DataStream& ds, const std::array<T, N>& v )
+{
+    for ( const auto& i : v ) ds << i;
+    return ds;
+}
+template <typename DataStream, typename T, size_t N>
+DataStream& operator>>( DataStream& ds, std::array<T, N>& v )
+{
+    for ( auto& i : v ) ds >> i;
+    return ds;
+}
+
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::set<T>& v )
+{
+    ds << unsigned_int( v.size() );
+    for ( const auto& i : v ) ds << i;
+    return ds;
+}
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::set<T>& v )
+{
+    unsigned_int size;
+    ds >> size;
+    v.clear();
+    for ( uint32_t i = 0; i < size.value; ++i ) {
+        T t;
+        ds >> t;
+        v.emplace( std::move( t ) );
+    }
+    return ds;
+}
+
+template <typename DataStream, typename K, typename V>
+DataStream& operator<<( DataStream& ds, const std::map<K, V>& v )
+{
+    ds << unsigned_int( v.size() );
+    for ( const auto& i : v ) ds << i.first << i.second;
+    return ds;
+}
+template <typename DataStream, typename K, typename V>
+DataStream& operator>>( DataStream& ds, std::map<K, V>& v )
+{
+    unsigned_int size;
+    ds >> size;
+    v.clear();
+    for ( uint32_t i = 0; i < size.value; ++i ) {
+        K k;
+        V val;
+        ds >> k >> val;
+        v.emplace( std::move( k ), std::move( val ) );
+    }
+    return ds;
+}
+
+template <typename DataStream, typename A, typename B>
+DataStream& operator<<( DataStream& ds, const std::pair<A, B>& v ) { return ds << v.first << v.second; }
+template <typename DataStream, typename A, typename B>
+DataStream& operator>>( DataStream& ds, std::pair<A, B>& v ) { return ds >> v.first >> v.second; }
+
+template <typename DataStream, typename... Ts>
+DataStream& operator<<( DataStream& ds, const std::tuple<Ts...>& v )
+{
+    std::apply( [&]( const auto&... items ) { ( ( ds << items ), ... ); }, v );
+    return ds;
+}
+template <typename DataStream, typename... Ts>
+DataStream& operator>>( DataStream& ds, std::tuple<Ts...>& v )
+{
+    std::apply( [&]( auto&... items ) { ( ( ds >> items ), ... ); }, v );
+    return ds;
+}
+
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const std::optional<T>& v )
+{
+    const bool valid = v.has_value();
+    ds << valid;
+    if ( valid ) ds << *v;
+    return ds;
+}
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, std::optional<T>& v )
+{
+    bool valid = false;
+    ds >> valid;
+    if ( valid ) {
+        T val;
+        ds >> val;
+        v = std::move( val );
+    } else {
+        v.reset();
+    }
+    return ds;
+}
+
+template <typename DataStream, typename T>
+DataStream& operator<<( DataStream& ds, const binary_extension<T>& v )
+{
+    if ( v.has_value() ) ds << v.value();
+    return ds;
+}
+template <typename DataStream, typename T>
+DataStream& operator>>( DataStream& ds, binary_extension<T>& v )
+{
+    if ( ds.remaining() ) {
+        T val;
+        ds >> val;
+        v.emplace( std::move( val ) );
+    } else {
+        v.reset();
+    }
+    return ds;
+}
+
+template <typename DataStream, typename T, std::enable_if_t<_datastream_detail::is_reflected<T>, int>>
+DataStream& operator<<( DataStream& ds, const T& v )
+{
+    _datastream_detail::for_each_field( v, [&]( const auto& field ) { ds << field; } );
+    return ds;
+}
+
+template <typename DataStream, typename T, std::enable_if_t<_datastream_detail::is_reflected<T>, int>>
+DataStream& operator>>( DataStream& ds, T& v )
+{
+    _datastream_detail::for_each_field( v, [&]( auto& field ) { ds >> field; } );
+    return ds;
+}
+
+template <typename T>
+size_t pack_size( const T& value )
+{
+    datastream<size_t> ps;
+    ps << value;
+    return ps.tellp();
+}
+
+template <typename T>
+std::vector<char> pack( const T& value )
+{
+    std::vector<char> result( pack_size( value ) );
+    datastream<char*> ds( result.data(), result.size() );
+    ds << value;
+    return result;
+}
+
+template <typename T>
+T unpack( const char* buffer, size_t len )
+{
+    T result;
+    datastream<const char*> ds( buffer, len );
+    ds >> result;
+    return result;
+}
+
+template <typename T>
+T unpack( const std::vector<char>& bytes )
+{
+    return unpack<T>( bytes.data(), bytes.size() );
+}
+
+} // namespace eosio
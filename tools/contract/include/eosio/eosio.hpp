@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Host stand-in for the subset of eosio.cdt used by `proxy.hpp`
+ *
+ * Headers keep the CDT layout & signatures so the contract sources compile unchanged; the intrinsics are
+ * implemented by the in-memory chain in `contract/chain.cpp`.
+ */
+#include "action.hpp"
+#include "asset.hpp"
+#include "binary_extension.hpp"
+#include "check.hpp"
+#include "contract.hpp"
+#include "crypto.hpp"
+#include "datastream.hpp"
+#include "multi_index.hpp"
+#include "name.hpp"
+#include "symbol.hpp"
+#include "system.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+typedef __int128 int128_t;
+typedef unsigned __int128 uint128_t;
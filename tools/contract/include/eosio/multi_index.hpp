@@ -0,0 +1,408 @@
+#pragma once
+
+#include "check.hpp"
+#include "datastream.hpp"
+#include "name.hpp"
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+namespace internal_use_do_not_use {
+    int32_t db_store_i64( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len );
+    void db_update_i64( int32_t iterator, uint64_t payer, const void* data, uint32_t len );
+    void db_remove_i64( int32_t iterator );
+    int32_t db_get_i64( int32_t iterator, const void* data, uint32_t len );
+    int32_t db_next_i64( int32_t iterator, uint64_t* primary );
+    int32_t db_previous_i64( int32_t iterator, uint64_t* primary );
+    int32_t db_find_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_lowerbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_upperbound_i64( uint64_t code, uint64_t scope, uint64_t table, uint64_t id );
+    int32_t db_end_i64( uint64_t code, uint64_t scope, uint64_t table );
+
+    int32_t db_idx64_store( uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const uint64_t* secondary );
+    void db_idx64_update( int32_t iterator, uint64_t payer, const uint64_t* secondary );
+    void db_idx64_remove( int32_t iterator );
+    int32_t db_idx64_next( int32_t iterator, uint64_t* primary );
+    int32_t db_idx64_previous( int32_t iterator, uint64_t* primary );
+    int32_t db_idx64_find_primary( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t primary );
+    int32_t db_idx64_find_secondary( uint64_t code, uint64_t scope, uint64_t table, const uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary, uint64_t* primary );
+    int32_t db_idx64_end( uint64_t code, uint64_t scope, uint64_t table );
+} // namespace internal_use_do_not_use
+
+name current_receiver();
+
+static constexpr name same_payer{};
+
+template <typename Class, typename Type, Type ( Class::*PtrToMemberFunction )() const>
+struct const_mem_fun {
+    typedef typename std::remove_reference<Type>::type result_type;
+
+    template <typename ChainedPtr>
+    auto operator()( const ChainedPtr& x ) const -> std::enable_if_t<!std::is_convertible<const ChainedPtr&, const Class&>::value, Type>
+    {
+        return operator()( *x );
+    }
+    Type operator()( const Class& x ) const { return ( x.*PtrToMemberFunction )(); }
+};
+
+template <name::raw IndexName, typename Extractor>
+struct indexed_by {
+    enum constants { index_name = static_cast<uint64_t>( IndexName ) };
+    typedef Extractor secondary_extractor_type;
+};
+
+/**
+ * Host `multi_index` over the `db_*_i64` / `db_idx64_*` intrinsics
+ *
+ * Only 64-bit secondary indices are supported (the only kind `proxy` declares). Objects are re-read from the
+ * database on every dereference, so rows patched through the raw intrinsics are seen by later lookups.
+ */
+template <name::raw TableName, typename T, typename... Indices>
+class multi_index {
+public:
+    static constexpr uint64_t table_name = static_cast<uint64_t>( TableName );
+
+    static constexpr uint64_t index_table( size_t n ) { return ( table_name & 0xFFFFFFFFFFFFFFF0ULL ) | n; }
+
+    struct const_iterator {
+        const T& operator*() const
+        {
+            check( !_end, "cannot dereference end iterator" );
+            return _multidx->load( _pk );
+        }
+        const T* operator->() const { return &**this; }
+
+        const_iterator& operator++()
+        {
+            using namespace internal_use_do_not_use;
+            check( !_end, "cannot increment end iterator" );
+            const int32_t itr = db_find_i64( _multidx->_code.value, _multidx->_scope, table_name, _pk );
+            check( itr >= 0, "cannot increment erased iterator" );
+            uint64_t next = 0;
+            if ( db_next_i64( itr, &next ) < 0 ) _end = true;
+            else _pk = next;
+            return *this;
+        }
+        const_iterator operator++( int ) { const_iterator copy = *this; ++*this; return copy; }
+
+        const_iterator& operator--()
+        {
+            using namespace internal_use_do_not_use;
+            uint64_t prev = 0;
+            const int32_t itr = _end ? db_end_i64( _multidx->_code.value, _multidx->_scope, table_name )
+                                     : db_find_i64( _multidx->_code.value, _multidx->_scope, table_name, _pk );
+            check( db_previous_i64( itr, &prev ) >= 0, "cannot decrement iterator at beginning of table" );
+            _pk = prev;
+            _end = false;
+            return *this;
+        }
+        const_iterator operator--( int ) { const_iterator copy = *this; --*this; return copy; }
+
+        friend bool operator==( const const_iterator& a, const const_iterator& b ) { return a._end == b._end && ( a._end || a._pk == b._pk ); }
+        friend bool operator!=( const const_iterator& a, const const_iterator& b ) { return !( a == b ); }
+
+        const multi_index*  _multidx = nullptr;
+        uint64_t            _pk = 0;
+        bool                _end = true;
+    };
+
+    template <size_t N, typename Extractor>
+    struct index {
+        static constexpr uint64_t index_table_name = multi_index::index_table( N );
+
+        struct const_iterator {
+            const T& operator*() const
+            {
+                check( !_end, "cannot dereference end iterator" );
+                return _idx->_multidx->load( _pk );
+            }
+            const T* operator->() const { return &**this; }
+
+            const_iterator& operator++()
+            {
+                using namespace internal_use_do_not_use;
+                check( !_end, "cannot increment end iterator" );
+                const auto* mi = _idx->_multidx;
+                uint64_t secondary = 0;
+                const int32_t itr = db_idx64_find_primary( mi->_code.value, mi->_scope, index_table_name, &secondary, _pk );
+                check( itr >= 0, "cannot increment erased iterator" );
+                uint64_t next = 0;
+                if ( db_idx64_next( itr, &next ) < 0 ) {
+                    _end = true;
+                } else {
+                    _pk = next;
+                    db_idx64_find_primary( mi->_code.value, mi->_scope, index_table_name, &_secondary, _pk );
+                }
+                return *this;
+            }
+            const_iterator operator++( int ) { const_iterator copy = *this; ++*this; return copy; }
+
+            const_iterator& operator--()
+            {
+                using namespace internal_use_do_not_use;
+                const auto* mi = _idx->_multidx;
+                uint64_t secondary = 0;
+                const int32_t itr = _end ? db_idx64_end( mi->_code.value, mi->_scope, index_table_name )
+                                         : db_idx64_find_primary( mi->_code.value, mi->_scope, index_table_name, &secondary, _pk );
+                uint64_t prev = 0;
+                check( db_idx64_previous( itr, &prev ) >= 0, "cannot decrement iterator at beginning of index" );
+                _pk = prev;
+                _end = false;
+                db_idx64_find_primary( mi->_code.value, mi->_scope, index_table_name, &_secondary, _pk );
+                return *this;
+            }
+            const_iterator operator--( int ) { const_iterator copy = *this; --*this; return copy; }
+
+            friend bool operator==( const const_iterator& a, const const_iterator& b ) { return a._end == b._end && ( a._end || a._pk == b._pk ); }
+            friend bool operator!=( const const_iterator& a, const const_iterator& b ) { return !( a == b ); }
+
+            const index*    _idx = nullptr;
+            uint64_t        _secondary = 0;
+            uint64_t        _pk = 0;
+            bool            _end = true;
+        };
+
+        const_iterator begin() const { return lower_bound( 0 ); }
+        const_iterator end() const { return const_iterator{ this, 0, 0, true }; }
+
+        const_iterator lower_bound( uint64_t secondary ) const
+        {
+            uint64_t primary = 0;
+            const int32_t itr = internal_use_do_not_use::db_idx64_lowerbound( _multidx->_code.value, _multidx->_scope, index_table_name, &secondary, &primary );
+            if ( itr < 0 ) return end();
+            return const_iterator{ this, secondary, primary, false };
+        }
+
+        const_iterator upper_bound( uint64_t secondary ) const
+        {
+            uint64_t primary = 0;
+            const int32_t itr = internal_use_do_not_use::db_idx64_upperbound( _multidx->_code.value, _multidx->_scope, index_table_name, &secondary, &primary );
+            if ( itr < 0 ) return end();
+            return const_iterator{ this, secondary, primary, false };
+        }
+
+        const_iterator find( uint64_t secondary ) const
+        {
+            auto lb = lower_bound( secondary );
+            if ( lb != end() && lb._secondary == secondary ) return lb;
+            return end();
+        }
+
+        const_iterator require_find( uint64_t secondary, const char* error_msg = "unable to find secondary key" ) const
+        {
+            auto itr = find( secondary );
+            check( itr != end(), error_msg );
+            return itr;
+        }
+
+        const T& get( uint64_t secondary, const char* error_msg = "unable to find secondary key" ) const { return *require_find( secondary, error_msg ); }
+
+        const_iterator iterator_to( const T& obj ) const { return const_iterator{ this, Extractor()( obj ), obj.primary_key(), false }; }
+
+        template <typename Lambda>
+        void modify( const_iterator itr, name payer, Lambda&& updater )
+        {
+            check( itr != end(), "cannot pass end iterator to modify" );
+            const_cast<multi_index*>( _multidx )->modify( *itr, payer, std::forward<Lambda>( updater ) );
+        }
+
+        const_iterator erase( const_iterator itr )
+        {
+            check( itr != end(), "cannot pass end iterator to erase" );
+            const T& obj = *itr;
+            ++itr;
+            const_cast<multi_index*>( _multidx )->erase( obj );
+            return itr;
+        }
+
+        const multi_index* _multidx;
+    };
+
+    multi_index( name code, uint64_t scope ) : _code( code ), _scope( scope ) {}
+
+    multi_index( const multi_index& ) = delete;
+    multi_index& operator=( const multi_index& ) = delete;
+
+    name get_code() const { return _code; }
+    uint64_t get_scope() const { return _scope; }
+
+    const_iterator begin() const { return lower_bound( 0 ); }
+    const_iterator end() const { return const_iterator{ this, 0, true }; }
+
+    const_iterator find( uint64_t primary ) const
+    {
+        const int32_t itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, table_name, primary );
+        if ( itr < 0 ) return end();
+        return const_iterator{ this, primary, false };
+    }
+
+    const_iterator require_find( uint64_t primary, const char* error_msg = "unable to find key" ) const
+    {
+        auto itr = find( primary );
+        check( itr != end(), error_msg );
+        return itr;
+    }
+
+    const T& get( uint64_t primary, const char* error_msg = "unable to find key" ) const { return *require_find( primary, error_msg ); }
+
+    const_iterator lower_bound( uint64_t primary ) const
+    {
+        const int32_t itr = internal_use_do_not_use::db_lowerbound_i64( _code.value, _scope, table_name, primary );
+        if ( itr < 0 ) return end();
+        return const_iterator{ this, load_object_by_primary_iterator( itr ).primary_key(), false };
+    }
+
+    const_iterator upper_bound( uint64_t primary ) const
+    {
+        const int32_t itr = internal_use_do_not_use::db_upperbound_i64( _code.value, _scope, table_name, primary );
+        if ( itr < 0 ) return end();
+        return const_iterator{ this, load_object_by_primary_iterator( itr ).primary_key(), false };
+    }
+
+    const_iterator iterator_to( const T& obj ) const { return const_iterator{ this, obj.primary_key(), false }; }
+
+    uint64_t available_primary_key() const
+    {
+        if ( begin() == end() ) return 0;
+        auto last = end();
+        --last;
+        return last->primary_key() + 1;
+    }
+
+    template <name::raw IndexName>
+    auto get_index() const
+    {
+        constexpr size_t n = index_position<IndexName>();
+        static_assert( n < sizeof...( Indices ), "name does not match any of the secondary indices" );
+        using extractor = typename std::tuple_element_t<n, std::tuple<Indices...>>::secondary_extractor_type;
+        return index<n, extractor>{ this };
+    }
+
+    template <typename Lambda>
+    const_iterator emplace( name payer, Lambda&& constructor )
+    {
+        using namespace internal_use_do_not_use;
+        check( _code == current_receiver(), "cannot create objects in table of another contract" );
+
+        auto obj = std::make_unique<T>();
+        constructor( *obj );
+        const uint64_t pk = obj->primary_key();
+        const auto data = pack( *obj );
+        db_store_i64( _scope, table_name, payer.value, pk, data.data(), data.size() );
+
+        const auto secondaries = extract_secondaries( *obj );
+        for ( size_t i = 0; i < secondaries.size(); ++i ) db_idx64_store( _scope, index_table( i ), payer.value, pk, &secondaries[i] );
+
+        _items[pk] = std::move( obj );
+        return const_iterator{ this, pk, false };
+    }
+
+    template <typename Lambda>
+    void modify( const_iterator itr, name payer, Lambda&& updater )
+    {
+        check( itr != end(), "cannot pass end iterator to modify" );
+        modify( *itr, payer, std::forward<Lambda>( updater ) );
+    }
+
+    template <typename Lambda>
+    void modify( const T& obj, name payer, Lambda&& updater )
+    {
+        using namespace internal_use_do_not_use;
+        check( _code == current_receiver(), "cannot modify objects in table of another contract" );
+
+        const uint64_t pk = obj.primary_key();
+        T& mutableobj = const_cast<T&>( load( pk ) );
+        const auto before = extract_secondaries( mutableobj );
+        updater( mutableobj );
+        check( pk == mutableobj.primary_key(), "updater cannot change primary key when modifying an object" );
+
+        const auto data = pack( mutableobj );
+        db_update_i64( db_find_i64( _code.value, _scope, table_name, pk ), payer.value, data.data(), data.size() );
+
+        const auto after = extract_secondaries( mutableobj );
+        for ( size_t i = 0; i < after.size(); ++i ) {
+            if ( before[i] == after[i] ) continue;
+            uint64_t secondary = 0;
+            const int32_t idx_itr = db_idx64_find_primary( _code.value, _scope, index_table( i ), &secondary, pk );
+            db_idx64_update( idx_itr, payer.value, &after[i] );
+        }
+    }
+
+    const_iterator erase( const_iterator itr )
+    {
+        check( itr != end(), "cannot pass end iterator to erase" );
+        const T& obj = *itr;
+        ++itr;
+        erase( obj );
+        return itr;
+    }
+
+    void erase( const T& obj )
+    {
+        using namespace internal_use_do_not_use;
+        check( _code == current_receiver(), "cannot erase objects in table of another contract" );
+
+        const uint64_t pk = obj.primary_key();
+        const int32_t itr = db_find_i64( _code.value, _scope, table_name, pk );
+        check( itr >= 0, "object passed to erase is not in multi_index" );
+
+        const auto secondaries = extract_secondaries( obj );
+        for ( size_t i = 0; i < secondaries.size(); ++i ) {
+            uint64_t secondary = 0;
+            db_idx64_remove( db_idx64_find_primary( _code.value, _scope, index_table( i ), &secondary, pk ) );
+        }
+        db_remove_i64( itr );
+        _items.erase( pk );
+    }
+
+private:
+    template <name::raw IndexName>
+    static constexpr size_t index_position()
+    {
+        constexpr uint64_t names[] = { static_cast<uint64_t>( Indices::index_name )..., 0 };
+        for ( size_t i = 0; i < sizeof...( Indices ); ++i ) {
+            if ( names[i] == static_cast<uint64_t>( IndexName ) ) return i;
+        }
+        return sizeof...( Indices );
+    }
+
+    static std::array<uint64_t, sizeof...( Indices )> extract_secondaries( const T& obj )
+    {
+        return { static_cast<uint64_t>( typename Indices::secondary_extractor_type()( obj ) )... };
+    }
+
+    const T& load_object_by_primary_iterator( int32_t itr ) const
+    {
+        using namespace internal_use_do_not_use;
+        const int32_t size = db_get_i64( itr, nullptr, 0 );
+        std::vector<char> buffer( size );
+        if ( size ) db_get_i64( itr, buffer.data(), size );
+
+        T obj = unpack<T>( buffer );
+        auto& slot = _items[obj.primary_key()];
+        if ( slot ) *slot = std::move( obj );
+        else slot = std::make_unique<T>( std::move( obj ) );
+        return *slot;
+    }
+
+    const T& load( uint64_t primary ) const
+    {
+        const int32_t itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, table_name, primary );
+        check( itr >= 0, "unable to find key" );
+        return load_object_by_primary_iterator( itr );
+    }
+
+    name                                                    _code;
+    uint64_t                                                _scope;
+    mutable std::map<uint64_t, std::unique_ptr<T>>          _items;
+};
+
+} // namespace eosio
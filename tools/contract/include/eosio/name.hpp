@@ -0,0 +1,68 @@
+#pragma once
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace eosio {
+
+struct name {
+    enum class raw : uint64_t {};
+
+    uint64_t value = 0;
+
+    constexpr name() = default;
+    constexpr explicit name( uint64_t v ) : value( v ) {}
+    constexpr name( raw r ) : value( static_cast<uint64_t>( r ) ) {}
+    constexpr explicit name( std::string_view str ) : value( 0 )
+    {
+        if ( str.size() > 13 ) throw check_failure( "string is too long to be a valid name" );
+        for ( size_t i = 0; i < str.size() && i < 12; ++i ) value |= ( char_to_value( str[i] ) & 0x1F ) << ( 64 - 5 * ( i + 1 ) );
+        if ( str.size() == 13 ) {
+            const uint64_t last = char_to_value( str[12] );
+            if ( last > 0x0F ) throw check_failure( "thirteenth character in name cannot be a letter that comes after j" );
+            value |= last;
+        }
+    }
+
+    static constexpr uint64_t char_to_value( char c )
+    {
+        if ( c == '.' ) return 0;
+        if ( c >= '1' && c <= '5' ) return ( c - '1' ) + 1;
+        if ( c >= 'a' && c <= 'z' ) return ( c - 'a' ) + 6;
+        throw check_failure( "character is not in allowed character set for names" );
+    }
+
+    constexpr operator raw() const { return raw( value ); }
+    constexpr explicit operator bool() const { return value != 0; }
+
+    std::string to_string() const
+    {
+        static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+        std::string str( 13, '.' );
+        uint64_t tmp = value;
+        for ( int i = 0; i <= 12; ++i ) {
+            str[12 - i] = charmap[tmp & ( i == 0 ? 0x0F : 0x1F )];
+            tmp >>= ( i == 0 ? 4 : 5 );
+        }
+        while ( !str.empty() && str.back() == '.' ) str.pop_back();
+        return str;
+    }
+
+    friend constexpr bool operator==( const name a, const name b ) { return a.value == b.value; }
+    friend constexpr bool operator!=( const name a, const name b ) { return a.value != b.value; }
+    friend constexpr bool operator<( const name a, const name b ) { return a.value < b.value; }
+};
+
+inline namespace literals {
+    template <typename T, T... Str>
+    inline constexpr name operator""_n()
+    {
+        constexpr const char buffer[] = { Str..., 0 };
+        return name( std::string_view( buffer, sizeof...( Str ) ) );
+    }
+}
+
+} // namespace eosio
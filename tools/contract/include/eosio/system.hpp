@@ -0,0 +1,9 @@
+#pragma once
+
+#include "time.hpp"
+
+namespace eosio {
+
+time_point current_time_point();
+
+} // namespace eosio
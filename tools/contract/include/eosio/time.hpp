@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eosio {
+
+class microseconds {
+public:
+    constexpr explicit microseconds( int64_t c = 0 ) : _count( c ) {}
+
+    constexpr int64_t count() const { return _count; }
+    constexpr int64_t to_seconds() const { return _count / 1000000; }
+
+    constexpr microseconds operator+( const microseconds& m ) const { return microseconds( _count + m._count ); }
+    constexpr microseconds operator-( const microseconds& m ) const { return microseconds( _count - m._count ); }
+    constexpr bool operator==( const microseconds& c ) const { return _count == c._count; }
+    constexpr bool operator!=( const microseconds& c ) const { return _count != c._count; }
+    constexpr bool operator<( const microseconds& c ) const { return _count < c._count; }
+
+    int64_t _count;
+};
+
+constexpr microseconds seconds( int64_t s ) { return microseconds( s * 1000000 ); }
+constexpr microseconds minutes( int64_t m ) { return seconds( 60 * m ); }
+constexpr microseconds hours( int64_t h ) { return minutes( 60 * h ); }
+constexpr microseconds days( int64_t d ) { return hours( 24 * d ); }
+
+class time_point {
+public:
+    constexpr explicit time_point( microseconds e = microseconds() ) : elapsed( e ) {}
+
+    constexpr const microseconds& time_since_epoch() const { return elapsed; }
+    constexpr uint32_t sec_since_epoch() const { return uint32_t( elapsed.count() / 1000000 ); }
+
+    constexpr time_point operator+( const microseconds& m ) const { return time_point( elapsed + m ); }
+    constexpr time_point operator-( const microseconds& m ) const { return time_point( elapsed - m ); }
+    constexpr bool operator==( const time_point& t ) const { return elapsed == t.elapsed; }
+    constexpr bool operator!=( const time_point& t ) const { return elapsed != t.elapsed; }
+    constexpr bool operator<( const time_point& t ) const { return elapsed < t.elapsed; }
+    constexpr bool operator<=( const time_point& t ) const { return !( t.elapsed < elapsed ); }
+    constexpr bool operator>( const time_point& t ) const { return t.elapsed < elapsed; }
+    constexpr bool operator>=( const time_point& t ) const { return !( elapsed < t.elapsed ); }
+
+    microseconds elapsed;
+};
+
+class time_point_sec {
+public:
+    constexpr time_point_sec() : utc_seconds( 0 ) {}
+    constexpr explicit time_point_sec( uint32_t seconds ) : utc_seconds( seconds ) {}
+    constexpr time_point_sec( const time_point& t ) : utc_seconds( uint32_t( t.time_since_epoch().count() / 1000000ll ) ) {}
+
+    static constexpr time_point_sec maximum() { return time_point_sec( 0xffffffff ); }
+    static constexpr time_point_sec min() { return time_point_sec( 0 ); }
+
+    constexpr operator time_point() const { return time_point( eosio::seconds( utc_seconds ) ); }
+    constexpr uint32_t sec_since_epoch() const { return utc_seconds; }
+
+    constexpr time_point_sec& operator+=( uint32_t m ) { utc_seconds += m; return *this; }
+    constexpr time_point_sec& operator-=( uint32_t m ) { utc_seconds -= m; return *this; }
+    constexpr time_point_sec operator+( uint32_t offset ) const { return time_point_sec( utc_seconds + offset ); }
+    constexpr time_point_sec operator-( uint32_t offset ) const { return time_point_sec( utc_seconds - offset ); }
+
+    friend constexpr bool operator==( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds == b.utc_seconds; }
+    friend constexpr bool operator!=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds != b.utc_seconds; }
+    friend constexpr bool operator<( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds < b.utc_seconds; }
+    friend constexpr bool operator<=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds <= b.utc_seconds; }
+    friend constexpr bool operator>( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds > b.utc_seconds; }
+    friend constexpr bool operator>=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds >= b.utc_seconds; }
+
+    // mixed comparisons, otherwise ambiguous between the two implicit conversions
+    friend constexpr bool operator<( const time_point& a, const time_point_sec& b ) { return a < time_point( b ); }
+    friend constexpr bool operator<=( const time_point& a, const time_point_sec& b ) { return a <= time_point( b ); }
+    friend constexpr bool operator>( const time_point& a, const time_point_sec& b ) { return a > time_point( b ); }
+    friend constexpr bool operator>=( const time_point& a, const time_point_sec& b ) { return a >= time_point( b ); }
+
+    uint32_t utc_seconds;
+};
+
+} // namespace eosio
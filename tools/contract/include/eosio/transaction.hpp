@@ -0,0 +1,57 @@
+#pragma once
+
+#include "action.hpp"
+#include "time.hpp"
+#include "varint.hpp"
+
+#include <vector>
+
+namespace eosio {
+
+size_t transaction_size();
+size_t read_transaction( char* buffer, size_t size );
+
+class transaction_header {
+public:
+    transaction_header( time_point_sec exp = time_point_sec() ) : expiration( exp ) {}
+
+    time_point_sec  expiration;
+    uint16_t        ref_block_num = 0;
+    uint32_t        ref_block_prefix = 0;
+    unsigned_int    max_net_usage_words = 0UL;
+    uint8_t         max_cpu_usage_ms = 0UL;
+    unsigned_int    delay_sec = 0UL;
+};
+
+class transaction : public transaction_header {
+public:
+    transaction( time_point_sec exp = time_point_sec() ) : transaction_header( exp ) {}
+
+    std::vector<action>                                     context_free_actions;
+    std::vector<action>                                     actions;
+    std::vector<std::pair<uint16_t, std::vector<char>>>     transaction_extensions;
+};
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const transaction_header& v )
+{
+    return ds << v.expiration << v.ref_block_num << v.ref_block_prefix << v.max_net_usage_words << v.max_cpu_usage_ms << v.delay_sec;
+}
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, transaction_header& v )
+{
+    return ds >> v.expiration >> v.ref_block_num >> v.ref_block_prefix >> v.max_net_usage_words >> v.max_cpu_usage_ms >> v.delay_sec;
+}
+
+template <typename DataStream>
+DataStream& operator<<( DataStream& ds, const transaction& v )
+{
+    return ds << static_cast<const transaction_header&>( v ) << v.context_free_actions << v.actions << v.transaction_extensions;
+}
+template <typename DataStream>
+DataStream& operator>>( DataStream& ds, transaction& v )
+{
+    return ds >> static_cast<transaction_header&>( v ) >> v.context_free_actions >> v.actions >> v.transaction_extensions;
+}
+
+} // namespace eosio
@@ -0,0 +1,44 @@
+#include "batch_controller.hpp"
+
+#include <algorithm>
+
+namespace proxy_tools {
+
+batch_controller::batch_controller( const batch_config& config )
+    : _config( config ), _limit( 0 )
+{
+    _limit = clamp( config.initial_limit );
+}
+
+uint64_t batch_controller::clamp( uint64_t limit ) const
+{
+    return std::max( _config.min_limit, std::min( _config.max_limit, limit ) );
+}
+
+uint32_t batch_controller::inflight( uint64_t due ) const
+{
+    if ( due == 0 ) return 0;
+    const uint64_t batches = ( due + _limit - 1 ) / _limit;
+    return static_cast<uint32_t>( std::min<uint64_t>( batches, _config.max_inflight ) );
+}
+
+void batch_controller::on_success( uint64_t claimed, uint64_t cpu_usage_us )
+{
+    _backoff = std::chrono::milliseconds( 0 );
+    if ( claimed == 0 ) return;
+
+    const double sample = static_cast<double>( cpu_usage_us ) / claimed;
+    _cost_us = _cost_us == 0 ? sample : _config.smoothing * sample + ( 1 - _config.smoothing ) * _cost_us;
+    if ( _cost_us <= 0 ) return;
+
+    const uint64_t target = static_cast<uint64_t>( _config.target_cpu_us / _cost_us );
+    _limit = clamp( std::min( target, _limit * 2 ) );
+}
+
+void batch_controller::on_failure( bool cpu_deadline )
+{
+    if ( cpu_deadline ) _limit = clamp( _limit / 2 );
+    _backoff = _backoff.count() == 0 ? _config.backoff_initial : std::min( _backoff * 2, _config.backoff_max );
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace proxy_tools {
+
+struct batch_config {
+    uint64_t    min_limit = 1;              // smallest `claimall` batch
+    uint64_t    max_limit = 500;            // largest `claimall` batch
+    uint64_t    initial_limit = 50;         // batch before any CPU has been measured
+    uint64_t    target_cpu_us = 100000;     // CPU a single transaction should use (below the deadline)
+    double      smoothing = 0.3;            // weight of the newest per-voter CPU sample
+    uint32_t    max_inflight = 4;           // transactions pushed concurrently
+    std::chrono::milliseconds backoff_initial{ 500 };
+    std::chrono::milliseconds backoff_max{ 60000 };
+};
+
+/**
+ * Sizes `claimall` batches from the measured CPU of previous transactions
+ *
+ * The per-voter CPU cost is smoothed (EWMA) and the next batch is `target_cpu_us / cost`, growing at most 2x per sample.
+ * A CPU deadline failure halves the batch; any failure doubles the backoff delay until the next success.
+ */
+class batch_controller {
+public:
+    explicit batch_controller( const batch_config& config = batch_config{} );
+
+    uint64_t limit() const { return _limit; }
+    double cost_per_voter_us() const { return _cost_us; }
+    std::chrono::milliseconds backoff() const { return _backoff; }
+
+    // number of transactions worth pushing concurrently for `due` voters
+    uint32_t inflight( uint64_t due ) const;
+
+    void on_success( uint64_t claimed, uint64_t cpu_usage_us );
+    void on_failure( bool cpu_deadline );
+
+private:
+    batch_config                _config;
+    uint64_t                    _limit;
+    double                      _cost_us = 0;
+    std::chrono::milliseconds   _backoff{ 0 };
+
+    uint64_t clamp( uint64_t limit ) const;
+};
+
+} // namespace proxy_tools
@@ -0,0 +1,179 @@
+#include "chain_rpc.hpp"
+
+namespace proxy_tools {
+
+namespace {
+
+// every claimed voter gets a `receipt` inline action from the contract, the owner's
+// `require_recipient` notification repeats the same act with the owner as receiver
+uint64_t count_receipts( const json& traces, const std::string& contract )
+{
+    uint64_t count = 0;
+    for ( const json& trace : traces.items() ) {
+        if ( trace.contains( "act" ) && trace.contains( "receiver" )
+            && trace["receiver"].as_string() == contract
+            && trace["act"]["name"].as_string() == "receipt"
+            && trace["act"]["account"].as_string() == contract ) ++count;
+        if ( trace.contains( "inline_traces" ) ) count += count_receipts( trace["inline_traces"], contract );
+    }
+    return count;
+}
+
+} // namespace
+
+chain_rpc::chain_rpc( const std::string& node_url, const std::string& wallet_url )
+    : _node( node_url ), _wallet( wallet_url )
+{}
+
+json chain_rpc::call( const http_client& client, const std::string& path, const json& body ) const
+{
+    const http_response response = client.post( path, body.dump() );
+    json result = json::parse( response.body );
+    if ( response.status != 200 && response.status != 202 ) {
+        std::string what = "rpc: " + path + " returned " + std::to_string( response.status );
+        if ( result.is_object() && result.contains( "error" ) && result["error"].is_object() && result["error"].contains( "name" ) ) {
+            what += " (" + result["error"]["name"].as_string() + ")";
+        }
+        throw http_error( what );
+    }
+    return result;
+}
+
+chain_info chain_rpc::get_info() const
+{
+    const json info = call( _node, "/v1/chain/get_info", json::object() );
+
+    chain_info result;
+    result.chain_id = info["chain_id"].as_string();
+    result.head_block_num = info["head_block_num"].as_uint64();
+    result.head_block_time = string_to_time_point_sec( info["head_block_time"].as_string() );
+
+    // TAPOS references the head block: low 16 bits of its number and bytes 8..11 of its id
+    const std::vector<uint8_t> id = from_hex( info["head_block_id"].as_string() );
+    if ( id.size() < 12 ) throw http_error( "rpc: invalid head_block_id" );
+    result.ref_block_num = static_cast<uint16_t>( result.head_block_num & 0xFFFF );
+    result.ref_block_prefix = id[8] | ( id[9] << 8 ) | ( id[10] << 16 ) | ( static_cast<uint32_t>( id[11] ) << 24 );
+    return result;
+}
+
+uint64_t chain_rpc::count_due( uint64_t contract, uint32_t now, uint64_t limit ) const
+{
+    json body = json::object();
+    body["code"] = name_to_string( contract );
+    body["scope"] = name_to_string( contract );
+    body["table"] = "voters.v2";
+    body["index_position"] = "2";
+    body["key_type"] = "i64";
+    body["lower_bound"] = "0";
+    body["upper_bound"] = std::to_string( now );
+    body["limit"] = limit;
+    body["json"] = true;
+
+    const json rows = call( _node, "/v1/chain/get_table_rows", body );
+    return rows["rows"].size();
+}
+
+std::optional<uint32_t> chain_rpc::next_due( uint64_t contract, uint32_t now ) const
+{
+    json body = json::object();
+    body["code"] = name_to_string( contract );
+    body["scope"] = name_to_string( contract );
+    body["table"] = "voters.v2";
+    body["index_position"] = "2";
+    body["key_type"] = "i64";
+    body["lower_bound"] = std::to_string( static_cast<uint64_t>( now ) + 1 );
+    body["limit"] = 1;
+    body["json"] = true;
+
+    const json rows = call( _node, "/v1/chain/get_table_rows", body );
+    if ( rows["rows"].size() == 0 ) return std::nullopt;
+    return string_to_time_point_sec( rows["rows"][0]["next_claim_period"].as_string() );
+}
+
+json chain_rpc::to_json( const transaction& trx )
+{
+    json result = json::object();
+    result["expiration"] = time_point_sec_to_string( trx.expiration );
+    result["ref_block_num"] = static_cast<uint64_t>( trx.ref_block_num );
+    result["ref_block_prefix"] = static_cast<uint64_t>( trx.ref_block_prefix );
+    result["max_net_usage_words"] = static_cast<uint64_t>( trx.max_net_usage_words );
+    result["max_cpu_usage_ms"] = static_cast<uint64_t>( trx.max_cpu_usage_ms );
+    result["delay_sec"] = static_cast<uint64_t>( trx.delay_sec );
+    result["context_free_actions"] = json::array();
+    json& actions = result["actions"] = json::array();
+    for ( const action& act : trx.actions ) {
+        json a = json::object();
+        a["account"] = name_to_string( act.account );
+        a["name"] = name_to_string( act.name );
+        json& auths = a["authorization"] = json::array();
+        for ( const permission_level& auth : act.authorization ) {
+            json p = json::object();
+            p["actor"] = name_to_string( auth.actor );
+            p["permission"] = name_to_string( auth.permission );
+            auths.push_back( p );
+        }
+        a["data"] = to_hex( act.data.data(), act.data.size() );
+        actions.push_back( a );
+    }
+    result["transaction_extensions"] = json::array();
+    return result;
+}
+
+std::vector<std::string> chain_rpc::required_keys( const transaction& trx ) const
+{
+    const json available = call( _wallet, "/v1/wallet/get_public_keys", json::array() );
+
+    json body = json::object();
+    body["transaction"] = to_json( trx );
+    body["available_keys"] = available;
+    const json required = call( _node, "/v1/chain/get_required_keys", body );
+
+    std::vector<std::string> keys;
+    for ( const json& key : required["required_keys"].items() ) keys.push_back( key.as_string() );
+    return keys;
+}
+
+push_result chain_rpc::push( const transaction& trx, const std::vector<std::string>& keys, const std::string& chain_id ) const
+{
+    push_result result;
+    try {
+        json sign = json::array();
+        sign.push_back( to_json( trx ) );
+        json& key_list = sign.push_back( json::array() );
+        for ( const std::string& key : keys ) key_list.push_back( key );
+        sign.push_back( chain_id );
+        const json signed_trx = call( _wallet, "/v1/wallet/sign_transaction", sign );
+
+        const std::vector<uint8_t> packed = trx.pack();
+        json body = json::object();
+        body["signatures"] = signed_trx["signatures"];
+        body["compression"] = "none";
+        body["packed_context_free_data"] = "";
+        body["packed_trx"] = to_hex( packed.data(), packed.size() );
+
+        const http_response response = _node.post( "/v1/chain/push_transaction", body.dump() );
+        const json reply = json::parse( response.body );
+        if ( response.status == 200 || response.status == 202 ) {
+            result.ok = true;
+            result.transaction_id = reply["transaction_id"].as_string();
+            result.cpu_usage_us = reply["processed"]["receipt"]["cpu_usage_us"].as_uint64();
+            if ( reply["processed"].contains( "action_traces" ) ) {
+                result.claimed = count_receipts( reply["processed"]["action_traces"], name_to_string( trx.actions[0].account ) );
+            }
+            return result;
+        }
+
+        const json& error = reply["error"];
+        const std::string name = error.contains( "name" ) ? error["name"].as_string() : "";
+        std::string message = name;
+        if ( error.contains( "details" ) && error["details"].size() > 0 ) message += ": " + error["details"][0]["message"].as_string();
+
+        result.error = message;
+        result.cpu_deadline = name == "deadline_exception" || name == "tx_cpu_usage_exceeded" || name == "leeway_deadline_exception";
+    } catch ( const std::exception& e ) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace proxy_tools
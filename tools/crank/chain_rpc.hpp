@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../common/eosio.hpp"
+#include "../common/http.hpp"
+#include "../common/json.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace proxy_tools {
+
+struct chain_info {
+    std::string     chain_id;
+    uint32_t        head_block_num = 0;
+    uint32_t        head_block_time = 0;
+    uint16_t        ref_block_num = 0;
+    uint32_t        ref_block_prefix = 0;
+};
+
+struct push_result {
+    bool            ok = false;
+    bool            cpu_deadline = false;   // failed on CPU deadline (batch too large)
+    uint64_t        cpu_usage_us = 0;
+    std::optional<uint64_t> claimed;        // `receipt` inline actions in the trace, when the node returns traces
+    std::string     transaction_id;
+    std::string     error;
+};
+
+/**
+ * nodeos chain API & keosd wallet API calls used by the crank
+ */
+class chain_rpc {
+public:
+    chain_rpc( const std::string& node_url, const std::string& wallet_url );
+
+    chain_info get_info() const;
+
+    // due voters from the `bynextclaim` index of `voters.v2` (next_claim_period <= now), capped at `limit`
+    uint64_t count_due( uint64_t contract, uint32_t now, uint64_t limit ) const;
+
+    // earliest `next_claim_period` strictly after `now`
+    std::optional<uint32_t> next_due( uint64_t contract, uint32_t now ) const;
+
+    // public keys required to authorize `trx` (resolved once from keosd available keys)
+    std::vector<std::string> required_keys( const transaction& trx ) const;
+
+    push_result push( const transaction& trx, const std::vector<std::string>& keys, const std::string& chain_id ) const;
+
+    static json to_json( const transaction& trx );
+
+private:
+    http_client     _node;
+    http_client     _wallet;
+
+    json call( const http_client& client, const std::string& path, const json& body ) const;
+};
+
+} // namespace proxy_tools
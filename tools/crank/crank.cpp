@@ -0,0 +1,108 @@
+#include "crank.hpp"
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <thread>
+
+namespace proxy_tools {
+
+crank::crank( const chain_rpc& rpc, const crank_config& config )
+    : _rpc( rpc ), _config( config ), _controller( config.batch ), _keys( config.keys )
+{}
+
+transaction crank::claimall_transaction( const crank_config& config, const chain_info& info, uint64_t limit, uint32_t slot )
+{
+    transaction trx;
+    // concurrent transactions share TAPOS, a distinct expiration keeps their ids unique
+    trx.expiration = info.head_block_time + config.expiration_sec + slot;
+    trx.ref_block_num = info.ref_block_num;
+    trx.ref_block_prefix = info.ref_block_prefix;
+
+    packer data;
+    data.u64( limit );
+
+    action act;
+    act.account = config.contract;
+    act.name = string_to_name( "claimall" );
+    act.authorization.push_back( config.authorization );
+    act.data = data.data();
+    trx.actions.push_back( act );
+    return trx;
+}
+
+cycle_stats crank::run_once()
+{
+    cycle_stats stats;
+    const chain_info info = _rpc.get_info();
+    const uint64_t window = static_cast<uint64_t>( _config.batch.max_inflight ) * _controller.limit();
+    stats.due = _rpc.count_due( _config.contract, info.head_block_time, window );
+
+    const uint32_t count = _controller.inflight( stats.due );
+    if ( count == 0 ) return stats;
+
+    const uint64_t limit = _controller.limit();
+    if ( _keys.empty() ) _keys = _rpc.required_keys( claimall_transaction( _config, info, limit, 0 ) );
+
+    std::vector<std::future<push_result>> pending;
+    for ( uint32_t slot = 0; slot < count; ++slot ) {
+        const transaction trx = claimall_transaction( _config, info, limit, slot );
+        pending.push_back( std::async( std::launch::async, [this, trx, &info] {
+            return _rpc.push( trx, _keys, info.chain_id );
+        }));
+    }
+
+    uint64_t remaining = stats.due;
+    for ( auto& future : pending ) {
+        const push_result result = future.get();
+        ++stats.pushed;
+        if ( result.ok ) {
+            // without traces, assume batches claimed in order from the due count
+            const uint64_t claimed = result.claimed ? *result.claimed : std::min( remaining, limit );
+            remaining -= std::min( remaining, claimed );
+            stats.claimed += claimed;
+            stats.cpu_usage_us += result.cpu_usage_us;
+            _controller.on_success( claimed, result.cpu_usage_us );
+        } else {
+            ++stats.failed;
+            _controller.on_failure( result.cpu_deadline );
+            std::cerr << "crank: claimall(" << limit << ") failed: " << result.error << std::endl;
+        }
+    }
+    return stats;
+}
+
+void crank::run( const std::atomic<bool>& stop )
+{
+    while ( !stop ) {
+        std::chrono::milliseconds sleep = _config.poll;
+        try {
+            const cycle_stats stats = run_once();
+            if ( stats.pushed ) {
+                std::cout << "crank: due=" << stats.due << " pushed=" << stats.pushed << " failed=" << stats.failed
+                          << " claimed=" << stats.claimed << " cpu_us=" << stats.cpu_usage_us
+                          << " next_limit=" << _controller.limit() << std::endl;
+            }
+            if ( stats.failed ) {
+                sleep = _controller.backoff();
+            } else if ( stats.pushed ) {
+                sleep = std::chrono::milliseconds( 0 );     // more voters may be due, keep the pipeline full
+            } else {
+                // idle: wake up when the next voter becomes due
+                const chain_info info = _rpc.get_info();
+                if ( const auto next = _rpc.next_due( _config.contract, info.head_block_time ) ) {
+                    sleep = std::min( sleep, std::chrono::milliseconds( ( *next - info.head_block_time ) * 1000 ) );
+                }
+            }
+        } catch ( const std::exception& e ) {
+            _controller.on_failure( false );
+            sleep = _controller.backoff();
+            std::cerr << "crank: " << e.what() << std::endl;
+        }
+        for ( auto slept = std::chrono::milliseconds( 0 ); slept < sleep && !stop; slept += std::chrono::milliseconds( 100 ) ) {
+            std::this_thread::sleep_for( std::min( std::chrono::milliseconds( 100 ), sleep - slept ) );
+        }
+    }
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "batch_controller.hpp"
+#include "chain_rpc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace proxy_tools {
+
+struct crank_config {
+    uint64_t                    contract = string_to_name( "proxy4nation" );
+    permission_level            authorization{ string_to_name( "proxy4nation" ), string_to_name( "active" ) };
+    std::vector<std::string>    keys;                                   // resolved from keosd when empty
+    uint32_t                    expiration_sec = 60;
+    std::chrono::milliseconds   poll{ 5000 };                           // maximum idle sleep
+    batch_config                batch;
+};
+
+struct cycle_stats {
+    uint64_t        due = 0;                // due voters seen at the start of the cycle
+    uint32_t        pushed = 0;             // transactions pushed
+    uint32_t        failed = 0;             // transactions failed
+    uint64_t        claimed = 0;            // voters claimed (from traces, else estimated from each batch limit)
+    uint64_t        cpu_usage_us = 0;       // CPU billed for successful transactions
+};
+
+/**
+ * Crank driving `claimall` from the `bynextclaim` index
+ *
+ * Each cycle counts the due voters, pushes up to `max_inflight` concurrent `claimall(limit)` transactions sized by the
+ * `batch_controller`, then feeds their billed CPU back into the controller.
+ */
+class crank {
+public:
+    crank( const chain_rpc& rpc, const crank_config& config );
+
+    cycle_stats run_once();
+    void run( const std::atomic<bool>& stop );
+
+    const batch_controller& controller() const { return _controller; }
+
+    static transaction claimall_transaction( const crank_config& config, const chain_info& info, uint64_t limit, uint32_t slot );
+
+private:
+    const chain_rpc&            _rpc;
+    crank_config                _config;
+    batch_controller            _controller;
+    std::vector<std::string>    _keys;
+};
+
+} // namespace proxy_tools
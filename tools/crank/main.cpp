@@ -0,0 +1,86 @@
+#include "crank.hpp"
+
+#include <csignal>
+#include <iostream>
+
+using namespace proxy_tools;
+
+namespace {
+
+std::atomic<bool> stop{ false };
+
+void usage()
+{
+    std::cerr <<
+        "usage: proxy-crank [options]\n"
+        "  --url <http://host:port>         nodeos chain API (default http://127.0.0.1:8888)\n"
+        "  --wallet-url <http://host:port>  keosd wallet API (default http://127.0.0.1:6666)\n"
+        "  --contract <name>                proxy contract (default proxy4nation)\n"
+        "  --permission <actor@permission>  claimall authorization (default <contract>@active)\n"
+        "  --public-key <key>               signing key (repeatable, default resolved from keosd)\n"
+        "  --target-cpu-us <us>             CPU per transaction to aim for (default 100000)\n"
+        "  --min-limit <n> --max-limit <n>  claimall batch bounds (default 1, 500)\n"
+        "  --initial-limit <n>              batch before CPU is measured (default 50)\n"
+        "  --max-inflight <n>               concurrent transactions (default 4)\n"
+        "  --poll-ms <ms>                   maximum idle sleep (default 5000)\n"
+        "  --once                           run a single cycle and exit\n";
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    std::string url = "http://127.0.0.1:8888";
+    std::string wallet_url = "http://127.0.0.1:6666";
+    std::string permission;
+    bool once = false;
+    crank_config config;
+
+    try {
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if ( i + 1 >= argc ) throw std::invalid_argument( "missing value for " + arg );
+                return argv[++i];
+            };
+            if ( arg == "--url" ) url = value();
+            else if ( arg == "--wallet-url" ) wallet_url = value();
+            else if ( arg == "--contract" ) config.contract = string_to_name( value() );
+            else if ( arg == "--permission" ) permission = value();
+            else if ( arg == "--public-key" ) config.keys.push_back( value() );
+            else if ( arg == "--target-cpu-us" ) config.batch.target_cpu_us = std::stoull( value() );
+            else if ( arg == "--min-limit" ) config.batch.min_limit = std::stoull( value() );
+            else if ( arg == "--max-limit" ) config.batch.max_limit = std::stoull( value() );
+            else if ( arg == "--initial-limit" ) config.batch.initial_limit = std::stoull( value() );
+            else if ( arg == "--max-inflight" ) config.batch.max_inflight = std::stoul( value() );
+            else if ( arg == "--poll-ms" ) config.poll = std::chrono::milliseconds( std::stoull( value() ) );
+            else if ( arg == "--once" ) once = true;
+            else { usage(); return arg == "--help" ? 0 : 1; }
+        }
+
+        config.authorization = { config.contract, string_to_name( "active" ) };
+        if ( !permission.empty() ) {
+            const size_t at = permission.find( '@' );
+            config.authorization.actor = string_to_name( permission.substr( 0, at ) );
+            if ( at != std::string::npos ) config.authorization.permission = string_to_name( permission.substr( at + 1 ) );
+        }
+
+        chain_rpc rpc( url, wallet_url );
+        crank runner( rpc, config );
+
+        if ( once ) {
+            const cycle_stats stats = runner.run_once();
+            std::cout << "due=" << stats.due << " pushed=" << stats.pushed << " failed=" << stats.failed
+                      << " claimed=" << stats.claimed << " cpu_us=" << stats.cpu_usage_us << std::endl;
+            return stats.failed ? 1 : 0;
+        }
+
+        std::signal( SIGINT, []( int ) { stop = true; } );
+        std::signal( SIGTERM, []( int ) { stop = true; } );
+        runner.run( stop );
+    } catch ( const std::exception& e ) {
+        std::cerr << "proxy-crank: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "epoch.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace proxy_tools {
+
+int64_t calculate_amount( int64_t staked, int64_t percentage, int64_t rate, int64_t interval, int64_t price )
+{
+    if ( price <= 0 ) return 0;
+    return static_cast<int64_t>( staked * rate / 10000.0 / 365.0 * percentage / 10000.0 / ( 86400.0 / interval ) * ( 10000.0 / price ) );
+}
+
+epoch_result build_epoch( const std::vector<reward_row>& rewards, const std::vector<voter_row>& voters,
+                          const std::unordered_map<uint64_t, portfolio_row>& portfolios, const epoch_params& params )
+{
+    const uint64_t EOS = string_to_symbol_code( "EOS" );
+
+    // one column per reward token, sorted by symbol code like the `setepoch` totals
+    std::vector<reward_row> tokens = rewards;
+    std::sort( tokens.begin(), tokens.end(), []( const reward_row& a, const reward_row& b ) { return ( a.symbol >> 8 ) < ( b.symbol >> 8 ); } );
+    std::vector<asset> totals;
+    for ( const reward_row& token : tokens ) totals.push_back( asset{ 0, token.symbol } );
+
+    epoch_result result;
+    for ( const voter_row& voter : voters ) {
+        if ( voter.next_claim_period > params.period || voter.staked <= 0 ) continue;
+
+        std::vector<int64_t> percentages( tokens.size(), 0 );
+        const auto set_percentage = [&]( const uint64_t sym_code, const int64_t percentage ) {
+            for ( size_t i = 0; i < tokens.size(); ++i ) {
+                if ( ( tokens[i].symbol >> 8 ) == sym_code ) percentages[i] += percentage;
+            }
+        };
+        const auto portfolio = portfolios.find( voter.owner );
+        if ( portfolio == portfolios.end() ) {
+            set_percentage( EOS, 10000 );
+        } else {
+            for ( size_t i = 0; i < portfolio->second.rewards.size() && i < portfolio->second.percentages.size(); ++i ) {
+                set_percentage( portfolio->second.rewards[i], portfolio->second.percentages[i] );
+            }
+        }
+
+        epoch_leaf leaf{ voter.owner, {} };
+        for ( size_t i = 0; i < tokens.size(); ++i ) {
+            const int64_t amount = calculate_amount( voter.staked, percentages[i], params.rate, params.interval, tokens[i].price.amount );
+            if ( amount <= 0 ) continue;
+            leaf.amounts.push_back( asset{ amount, tokens[i].symbol } );
+            totals[i].amount += amount;
+        }
+        if ( !leaf.amounts.empty() ) result.leaves.push_back( std::move( leaf ) );
+    }
+    if ( result.leaves.empty() ) throw std::runtime_error( "build_epoch: no voter is due" );
+
+    // tokens nobody is paid stay out of the epoch
+    for ( size_t i = 0; i < tokens.size(); ++i ) {
+        if ( totals[i].amount <= 0 ) continue;
+        result.totals.push_back( totals[i] );
+        result.contracts.push_back( tokens[i].contract );
+    }
+
+    std::sort( result.leaves.begin(), result.leaves.end(), []( const epoch_leaf& a, const epoch_leaf& b ) { return a.owner < b.owner; } );
+    result.root = build_tree( result.leaves ).root();
+    return result;
+}
+
+epoch_result build_epoch( const std::string& rewards, const std::string& voters, const std::string& portfolio, const epoch_params& params )
+{
+    std::vector<reward_row> reward_rows;
+    std::vector<voter_row> voter_rows;
+    std::unordered_map<uint64_t, portfolio_row> portfolio_rows;
+
+    read_dump( rewards, [&]( const json& row ) { reward_rows.push_back( parse_reward( row ) ); } );
+    read_dump( voters, [&]( const json& row ) { voter_rows.push_back( parse_voter( row ) ); } );
+    if ( !portfolio.empty() ) {
+        read_dump( portfolio, [&]( const json& row ) {
+            portfolio_row parsed = parse_portfolio( row );
+            portfolio_rows[parsed.owner] = std::move( parsed );
+        });
+    }
+    return build_epoch( reward_rows, voter_rows, portfolio_rows, params );
+}
+
+merkle_tree build_tree( const std::vector<epoch_leaf>& leaves )
+{
+    std::vector<checksum256> hashes;
+    hashes.reserve( leaves.size() );
+    for ( size_t i = 0; i < leaves.size(); ++i ) hashes.push_back( merkle_leaf( i, leaves[i].owner, leaves[i].amounts ) );
+    return merkle_tree( std::move( hashes ) );
+}
+
+void write_leaves( const std::string& path, const std::vector<epoch_leaf>& leaves )
+{
+    std::ofstream out( path, std::ios::trunc );
+    if ( !out ) throw std::runtime_error( "write_leaves: cannot open " + path );
+
+    for ( size_t i = 0; i < leaves.size(); ++i ) {
+        json row = json::object();
+        row["index"] = static_cast<uint64_t>( i );
+        row["owner"] = name_to_string( leaves[i].owner );
+        json amounts = json::array();
+        for ( const asset& amount : leaves[i].amounts ) amounts.push_back( asset_to_string( amount ) );
+        row["amounts"] = amounts;
+        out << row.dump() << '\n';
+    }
+    if ( !out ) throw std::runtime_error( "write_leaves: write failed " + path );
+}
+
+std::vector<epoch_leaf> read_leaves( const std::string& path )
+{
+    std::ifstream in( path );
+    if ( !in ) throw std::runtime_error( "read_leaves: cannot open " + path );
+
+    std::vector<epoch_leaf> leaves;
+    std::string line;
+    while ( std::getline( in, line ) ) {
+        if ( line.empty() ) continue;
+        const json row = json::parse( line );
+        if ( row["index"].as_uint64() != leaves.size() ) throw std::runtime_error( "read_leaves: leaves out of order" );
+        epoch_leaf leaf{ string_to_name( row["owner"].as_string() ), {} };
+        for ( const json& amount : row["amounts"].items() ) leaf.amounts.push_back( string_to_asset( amount.as_string() ) );
+        leaves.push_back( std::move( leaf ) );
+    }
+    return leaves;
+}
+
+} // namespace proxy_tools
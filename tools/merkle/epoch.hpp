@@ -0,0 +1,47 @@
+#pragma once
+
+#include "merkle.hpp"
+#include "../snapshot/rows.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace proxy_tools {
+
+struct epoch_leaf {
+    uint64_t            owner = 0;
+    std::vector<asset>  amounts;        // positive payouts, in the order of `epoch_result::totals`
+};
+
+struct epoch_params {
+    uint32_t    period = 0;             // voters with `next_claim_period <= period` are due
+    int64_t     rate = 185;             // `settings.rate`
+    int64_t     interval = 86400;       // `settings.interval`
+};
+
+struct epoch_result {
+    std::vector<epoch_leaf>     leaves;     // ordered by owner, leaf index = position
+    std::vector<asset>          totals;     // `setepoch` totals, sorted by symbol code
+    std::vector<uint64_t>       contracts;  // token contract of each total
+    checksum256                 root{};
+};
+
+// APR formula of `proxy::calculate_amount` (see README)
+int64_t calculate_amount( int64_t staked, int64_t percentage, int64_t rate, int64_t interval, int64_t price );
+
+// one leaf per due voter with a positive amount of any reward token, percentages from `portfolio2` (100% EOS without
+// one); tokens without a `rewards` row are left out
+epoch_result build_epoch( const std::vector<reward_row>& rewards, const std::vector<voter_row>& voters,
+                          const std::unordered_map<uint64_t, portfolio_row>& portfolios, const epoch_params& params );
+
+// same, reading `get_table_rows` dumps (portfolio optional)
+epoch_result build_epoch( const std::string& rewards, const std::string& voters, const std::string& portfolio, const epoch_params& params );
+
+merkle_tree build_tree( const std::vector<epoch_leaf>& leaves );
+
+// leaves file: one `{"index": 0, "owner": "myaccount", "amounts": ["0.2534 EOS", "50.6800 DAPP"]}` per line
+void write_leaves( const std::string& path, const std::vector<epoch_leaf>& leaves );
+std::vector<epoch_leaf> read_leaves( const std::string& path );
+
+} // namespace proxy_tools
@@ -0,0 +1,109 @@
+#include "epoch.hpp"
+
+#include <iostream>
+
+using namespace proxy_tools;
+
+namespace {
+
+void usage()
+{
+    std::cerr <<
+        "usage: proxy-merkle build --rewards <dump> --voters <dump> [--portfolio <dump>] --period <2019-08-07T00:00:00>\n"
+        "                          [--rate 185] [--interval 86400] [--epoch 1] [--expires <2019-09-07T00:00:00>] -o <leaves.jsonl>\n"
+        "       proxy-merkle proof <leaves.jsonl> <owner> [--epoch 1]\n"
+        "\n"
+        "build prints the `setepoch` arguments & writes the leaves, proof prints the `claimproof` arguments of an owner.\n";
+}
+
+json hex( const checksum256& value )
+{
+    return json( to_hex( value.data(), value.size() ) );
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    if ( argc < 3 ) { usage(); return 1; }
+    const std::string command = argv[1];
+
+    try {
+        if ( command == "build" ) {
+            std::string rewards, voters, portfolio, output, expires;
+            uint64_t epoch = 1;
+            epoch_params params;
+            for ( int i = 2; i + 1 < argc; i += 2 ) {
+                const std::string arg = argv[i];
+                if ( arg == "--rewards" ) rewards = argv[i + 1];
+                else if ( arg == "--voters" ) voters = argv[i + 1];
+                else if ( arg == "--portfolio" ) portfolio = argv[i + 1];
+                else if ( arg == "--period" ) params.period = string_to_time_point_sec( argv[i + 1] );
+                else if ( arg == "--rate" ) params.rate = std::stoll( argv[i + 1] );
+                else if ( arg == "--interval" ) params.interval = std::stoll( argv[i + 1] );
+                else if ( arg == "--epoch" ) epoch = std::stoull( argv[i + 1] );
+                else if ( arg == "--expires" ) expires = argv[i + 1];
+                else if ( arg == "-o" || arg == "--output" ) output = argv[i + 1];
+                else { usage(); return 1; }
+            }
+            if ( rewards.empty() || voters.empty() || output.empty() || !params.period ) { usage(); return 1; }
+
+            const epoch_result result = build_epoch( rewards, voters, portfolio, params );
+            write_leaves( output, result.leaves );
+
+            json totals = json::array();
+            for ( size_t i = 0; i < result.totals.size(); ++i ) {
+                json total = json::object();
+                total["quantity"] = asset_to_string( result.totals[i] );
+                total["contract"] = name_to_string( result.contracts[i] );
+                totals.push_back( total );
+            }
+
+            json args = json::array();
+            args.push_back( epoch );
+            args.push_back( hex( result.root ) );
+            args.push_back( totals );
+            args.push_back( static_cast<uint64_t>( result.leaves.size() ) );
+            args.push_back( time_point_sec_to_string( params.period ) );
+            args.push_back( expires.empty() ? time_point_sec_to_string( params.period + 30 * 86400 ) : expires );
+            std::cout << args.dump() << std::endl;
+            return 0;
+        }
+
+        if ( command == "proof" ) {
+            if ( argc < 4 ) { usage(); return 1; }
+            const std::vector<epoch_leaf> leaves = read_leaves( argv[2] );
+            const uint64_t owner = string_to_name( argv[3] );
+            uint64_t epoch = 1;
+            for ( int i = 4; i + 1 < argc; i += 2 ) {
+                if ( std::string( argv[i] ) == "--epoch" ) epoch = std::stoull( argv[i + 1] );
+                else { usage(); return 1; }
+            }
+
+            for ( uint64_t index = 0; index < leaves.size(); ++index ) {
+                if ( leaves[index].owner != owner ) continue;
+
+                json proof = json::array();
+                for ( const checksum256& sibling : build_tree( leaves ).proof( index ) ) proof.push_back( hex( sibling ) );
+
+                json args = json::array();
+                args.push_back( name_to_string( owner ) );
+                args.push_back( epoch );
+                args.push_back( index );
+                json amounts = json::array();
+                for ( const asset& amount : leaves[index].amounts ) amounts.push_back( asset_to_string( amount ) );
+                args.push_back( amounts );
+                args.push_back( proof );
+                std::cout << args.dump() << std::endl;
+                return 0;
+            }
+            std::cerr << "proxy-merkle: " << argv[3] << " is not in the epoch" << std::endl;
+            return 1;
+        }
+    } catch ( const std::exception& e ) {
+        std::cerr << "proxy-merkle: " << e.what() << std::endl;
+        return 1;
+    }
+    usage();
+    return 1;
+}
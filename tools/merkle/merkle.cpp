@@ -0,0 +1,73 @@
+#include "merkle.hpp"
+
+#include <stdexcept>
+
+namespace proxy_tools {
+
+checksum256 merkle_leaf( uint64_t index, uint64_t owner, const std::vector<asset>& amounts )
+{
+    packer data;
+    data.u64( index );
+    data.u64( owner );
+    data.varuint32( amounts.size() );
+    for ( const asset& amount : amounts ) data.pack( amount );
+    return sha256( data.data().data(), data.data().size() );
+}
+
+checksum256 merkle_node( const checksum256& left, const checksum256& right )
+{
+    uint8_t data[64];
+    std::copy( left.begin(), left.end(), data );
+    std::copy( right.begin(), right.end(), data + 32 );
+    return sha256( data, sizeof( data ) );
+}
+
+size_t merkle_depth( uint64_t leaves )
+{
+    size_t depth = 0;
+    for ( uint64_t width = leaves; width > 1; width = ( width + 1 ) / 2 ) ++depth;
+    return depth;
+}
+
+bool verify_proof( const checksum256& root, const checksum256& leaf, uint64_t index, uint64_t leaves, const std::vector<checksum256>& proof )
+{
+    if ( index >= leaves || proof.size() != merkle_depth( leaves ) ) return false;
+
+    checksum256 node = leaf;
+    for ( size_t i = 0; i < proof.size(); ++i ) {
+        node = ( index >> i ) & 1 ? merkle_node( proof[i], node ) : merkle_node( node, proof[i] );
+    }
+    return node == root;
+}
+
+merkle_tree::merkle_tree( std::vector<checksum256> leaves )
+{
+    if ( leaves.empty() ) throw std::invalid_argument( "merkle_tree: no leaves" );
+
+    _levels.push_back( std::move( leaves ) );
+    while ( _levels.back().size() > 1 ) {
+        const std::vector<checksum256>& below = _levels.back();
+        std::vector<checksum256> level;
+        level.reserve( ( below.size() + 1 ) / 2 );
+        for ( size_t i = 0; i < below.size(); i += 2 ) {
+            level.push_back( merkle_node( below[i], i + 1 < below.size() ? below[i + 1] : below[i] ) );
+        }
+        _levels.push_back( std::move( level ) );
+    }
+}
+
+std::vector<checksum256> merkle_tree::proof( uint64_t index ) const
+{
+    if ( index >= size() ) throw std::out_of_range( "merkle_tree: index out of range" );
+
+    std::vector<checksum256> siblings;
+    for ( size_t depth = 0; depth + 1 < _levels.size(); ++depth ) {
+        const std::vector<checksum256>& level = _levels[depth];
+        const uint64_t sibling = index ^ 1;
+        siblings.push_back( sibling < level.size() ? level[sibling] : level[index] );
+        index >>= 1;
+    }
+    return siblings;
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "sha256.hpp"
+#include "../common/eosio.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * Merkle tree of epoch rewards, mirrors `src/merkle.cpp`
+ *
+ * leaf = sha256( index:u64 | owner:u64 | count:varuint32 | ( amount:i64 | symbol:u64 ) * count ), little-endian,
+ *        17 + 16 * count bytes
+ * node = sha256( left | right ), 64 bytes
+ *
+ * A level with an odd number of nodes pairs its last node with itself.
+ */
+checksum256 merkle_leaf( uint64_t index, uint64_t owner, const std::vector<asset>& amounts );
+checksum256 merkle_node( const checksum256& left, const checksum256& right );
+size_t merkle_depth( uint64_t leaves );
+
+// same checks as `proxy::check_merkle_proof`
+bool verify_proof( const checksum256& root, const checksum256& leaf, uint64_t index, uint64_t leaves, const std::vector<checksum256>& proof );
+
+class merkle_tree {
+public:
+    explicit merkle_tree( std::vector<checksum256> leaves );
+
+    const checksum256& root() const { return _levels.back().front(); }
+    uint64_t size() const { return _levels.front().size(); }
+
+    // siblings from leaf to root, the `claimproof` proof
+    std::vector<checksum256> proof( uint64_t index ) const;
+
+private:
+    std::vector<std::vector<checksum256>> _levels;
+};
+
+} // namespace proxy_tools
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace proxy_tools {
+
+using checksum256 = std::array<uint8_t, 32>;
+
+// FIPS 180-4 SHA-256, matches the `eosio::sha256` intrinsic
+checksum256 sha256( const uint8_t* data, size_t size );
+
+} // namespace proxy_tools
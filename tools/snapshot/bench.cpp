@@ -0,0 +1,82 @@
+#include "export.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace proxy_tools;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since( clock_type::time_point start )
+{
+    return std::chrono::duration<double>( clock_type::now() - start ).count();
+}
+
+std::string synthetic_owner( uint64_t i )
+{
+    // 12 character names from the base-32 name alphabet
+    static const char* charmap = "12345abcdefghijklmnopqrstuvwxyz";
+    std::string name( 12, 'a' );
+    for ( int c = 11; c >= 0; --c, i /= 31 ) name[c] = charmap[i % 31];
+    return name;
+}
+
+} // namespace
+
+// synthetic `voters.v2` / `portfolio2` / `rewards` dumps => export time, file size & aggregate query time
+int main( int argc, char** argv )
+{
+    const uint64_t count = argc > 1 ? std::stoull( argv[1] ) : 1000000;
+    const std::string dir = argc > 2 ? argv[2] : "/tmp";
+    const export_paths paths{ dir + "/bench_rewards.json", dir + "/bench_voters.jsonl", dir + "/bench_portfolio.jsonl", dir + "/bench.pxsnap" };
+
+    std::mt19937_64 rng( 42 );
+    const char* referrals[] = { "", "tokenyieldio", "eosnationftw", "eosauthority" };
+    {
+        std::ofstream rewards( paths.rewards );
+        rewards << R"({"rows":[{"symbol":"4,EOS","contract":"eosio.token","price":"1.0000 EOS"},{"symbol":"4,DAPP","contract":"dappservices","price":"0.0050 EOS"},{"symbol":"4,USDT","contract":"tethertether","price":"0.3436 EOS"}],"more":false})" << "\n";
+
+        std::ofstream voters( paths.voters );
+        std::ofstream portfolio( paths.portfolio );
+        for ( uint64_t i = 0; i < count; ++i ) {
+            const std::string owner = synthetic_owner( i );
+            const bool dapp = rng() % 4 == 0;
+            voters << R"({"owner":")" << owner
+                   << R"(","next_claim_period":")" << time_point_sec_to_string( 1565000000 + rng() % 400000 )
+                   << R"(","staked":)" << rng() % 10000000000ULL
+                   << R"(,"referral":")" << referrals[rng() % 4]
+                   << R"(","rewards":)" << ( dapp ? R"(["DAPP","EOS"])" : R"(["EOS"])" )
+                   << R"(,"protocol_features":[{"key":"staked","value":)" << ( rng() % 2 ? "true" : "false" ) << "}]}\n";
+            if ( i % 10 == 0 ) portfolio << R"({"owner":")" << owner << R"(","rewards":["EOS","USDT"],"percentages":[9000,1000]})" << "\n";
+        }
+    }
+    std::ifstream dump( paths.voters, std::ios::ate | std::ios::binary );
+    const uint64_t dump_bytes = dump.tellg();
+
+    auto start = clock_type::now();
+    const export_stats stats = export_snapshot( paths );
+    const double export_sec = seconds_since( start );
+
+    start = clock_type::now();
+    snapshot_view view( paths.output );
+    const int64_t total = view.total_staked();
+    const uint64_t due = view.count_due( 1565200000 );
+    const int64_t by_referral = view.staked_by_referral( string_to_name( "tokenyieldio" ) );
+    const uint64_t holders = view.count_reward_holders( string_to_symbol_code( "DAPP" ) );
+    const double query_sec = seconds_since( start );
+
+    std::cout << "voters=" << stats.voters << " portfolios=" << stats.portfolios << "\n"
+              << "json_dump_bytes=" << dump_bytes << " snapshot_bytes=" << stats.bytes
+              << " bytes_per_voter=" << static_cast<double>( stats.bytes ) / stats.voters << "\n"
+              << "export_sec=" << export_sec << " voters_per_sec=" << stats.voters / export_sec << "\n"
+              << "query_sec=" << query_sec << " (total_staked=" << total << " due=" << due
+              << " staked_by_referral=" << by_referral << " dapp_holders=" << holders << ")" << std::endl;
+
+    for ( const std::string& path : { paths.rewards, paths.voters, paths.portfolio, paths.output } ) std::remove( path.c_str() );
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "columnar.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace proxy_tools {
+
+void snapshot_writer::add_reward( const reward_row& row )
+{
+    if ( _rewards.size() >= SNAPSHOT_MAX_REWARDS ) throw std::runtime_error( "snapshot: too many rewards" );
+    _rewards.push_back( row );
+}
+
+void snapshot_writer::add_voter( voter_row row )
+{
+    _voters.push_back( std::move( row ) );
+}
+
+void snapshot_writer::add_portfolio( portfolio_row row )
+{
+    if ( row.rewards.size() != row.percentages.size() ) throw std::runtime_error( "snapshot: portfolio rewards/percentages mismatch" );
+    _portfolios.push_back( std::move( row ) );
+}
+
+int32_t snapshot_writer::reward_index( uint64_t sym_code ) const
+{
+    for ( uint32_t i = 0; i < _rewards.size(); ++i ) {
+        if ( ( _rewards[i].symbol >> 8 ) == sym_code ) return i;
+    }
+    return -1;
+}
+
+namespace {
+
+class section_writer {
+public:
+    explicit section_writer( const std::string& path ) : _out( path, std::ios::binary | std::ios::trunc )
+    {
+        if ( !_out ) throw std::runtime_error( "snapshot: cannot write " + path );
+    }
+
+    uint64_t offset() const { return _offset; }
+
+    void write( const void* data, size_t size )
+    {
+        _out.write( static_cast<const char*>( data ), size );
+        _offset += size;
+    }
+
+    uint64_t align()
+    {
+        static const char zeros[8] = {};
+        write( zeros, ( 8 - _offset % 8 ) % 8 );
+        return _offset;
+    }
+
+    template <typename T>
+    uint64_t column( const std::vector<T>& values )
+    {
+        const uint64_t start = align();
+        write( values.data(), values.size() * sizeof( T ) );
+        return start;
+    }
+
+    void rewrite_header( const snapshot_header& header )
+    {
+        _out.seekp( 0 );
+        _out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+        _out.flush();
+        if ( !_out ) throw std::runtime_error( "snapshot: write failed" );
+    }
+
+private:
+    std::ofstream   _out;
+    uint64_t        _offset = 0;
+};
+
+} // namespace
+
+export_stats snapshot_writer::write( const std::string& path )
+{
+    std::sort( _voters.begin(), _voters.end(), []( const voter_row& a, const voter_row& b ) { return a.owner < b.owner; } );
+    std::sort( _portfolios.begin(), _portfolios.end(), []( const portfolio_row& a, const portfolio_row& b ) { return a.owner < b.owner; } );
+
+    const size_t n = _voters.size();
+    std::vector<uint64_t> owner( n ), referral( n ), reward_mask( n );
+    std::vector<int64_t> staked( n );
+    std::vector<uint32_t> next_claim( n ), portfolio_index( n + 1 );
+    std::vector<uint8_t> portfolio_reward;
+    std::vector<uint16_t> portfolio_percentage;
+
+    export_stats stats;
+    auto portfolio = _portfolios.begin();
+    for ( size_t i = 0; i < n; ++i ) {
+        const voter_row& voter = _voters[i];
+        owner[i] = voter.owner;
+        staked[i] = voter.staked;
+        next_claim[i] = voter.next_claim_period;
+        referral[i] = voter.referral;
+        for ( const uint64_t sym_code : voter.rewards ) {
+            const int32_t index = reward_index( sym_code );
+            if ( index < 0 ) ++stats.unknown_rewards;
+            else reward_mask[i] |= 1ULL << index;
+        }
+
+        // merge join on owner, portfolios of owners no longer in `voters.v2` are dropped
+        portfolio_index[i] = portfolio_reward.size();
+        while ( portfolio != _portfolios.end() && portfolio->owner < voter.owner ) ++portfolio;
+        if ( portfolio != _portfolios.end() && portfolio->owner == voter.owner ) {
+            ++stats.portfolios;
+            for ( size_t j = 0; j < portfolio->rewards.size(); ++j ) {
+                const int32_t index = reward_index( portfolio->rewards[j] );
+                if ( index < 0 ) {
+                    ++stats.unknown_rewards;
+                    continue;
+                }
+                portfolio_reward.push_back( static_cast<uint8_t>( index ) );
+                portfolio_percentage.push_back( static_cast<uint16_t>( portfolio->percentages[j] ) );
+            }
+        }
+    }
+    portfolio_index[n] = portfolio_reward.size();
+
+    std::vector<snapshot_reward> rewards;
+    for ( const reward_row& row : _rewards ) rewards.push_back( { row.symbol, row.contract, row.price.amount, row.price.symbol } );
+
+    snapshot_header header;
+    header.reward_count = rewards.size();
+    header.voter_count = n;
+    header.entry_count = portfolio_reward.size();
+
+    section_writer out( path );
+    out.write( &header, sizeof( header ) );
+    out.column( rewards );
+    header.owner_offset = out.column( owner );
+    header.staked_offset = out.column( staked );
+    header.next_claim_offset = out.column( next_claim );
+    header.referral_offset = out.column( referral );
+    header.reward_mask_offset = out.column( reward_mask );
+    header.portfolio_index_offset = out.column( portfolio_index );
+    header.portfolio_reward_offset = out.column( portfolio_reward );
+    header.portfolio_percentage_offset = out.column( portfolio_percentage );
+    header.file_size = out.align();
+    out.rewrite_header( header );
+
+    stats.voters = n;
+    stats.entries = header.entry_count;
+    stats.bytes = header.file_size;
+    return stats;
+}
+
+snapshot_view::snapshot_view( const std::string& path )
+{
+    const int fd = ::open( path.c_str(), O_RDONLY );
+    if ( fd < 0 ) throw std::runtime_error( "snapshot: cannot open " + path );
+    struct stat st{};
+    ::fstat( fd, &st );
+    _size = st.st_size;
+    if ( _size < sizeof( snapshot_header ) ) {
+        ::close( fd );
+        throw std::runtime_error( "snapshot: file too small " + path );
+    }
+    void* data = ::mmap( nullptr, _size, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+    if ( data == MAP_FAILED ) throw std::runtime_error( "snapshot: mmap failed " + path );
+
+    _data = static_cast<const uint8_t*>( data );
+    _header = reinterpret_cast<const snapshot_header*>( _data );
+    if ( _header->magic != SNAPSHOT_MAGIC || _header->version != SNAPSHOT_VERSION || _header->file_size != _size ) {
+        ::munmap( data, _size );
+        throw std::runtime_error( "snapshot: invalid header " + path );
+    }
+}
+
+snapshot_view::~snapshot_view()
+{
+    ::munmap( const_cast<uint8_t*>( _data ), _size );
+}
+
+int64_t snapshot_view::find( uint64_t value ) const
+{
+    const uint64_t* begin = owner();
+    const uint64_t* end = begin + size();
+    const uint64_t* itr = std::lower_bound( begin, end, value );
+    return itr != end && *itr == value ? itr - begin : -1;
+}
+
+int64_t snapshot_view::total_staked() const
+{
+    const int64_t* column = staked();
+    int64_t total = 0;
+    for ( uint64_t i = 0; i < size(); ++i ) total += column[i];
+    return total;
+}
+
+uint64_t snapshot_view::count_due( uint32_t now ) const
+{
+    const uint32_t* column = next_claim_period();
+    uint64_t count = 0;
+    for ( uint64_t i = 0; i < size(); ++i ) count += column[i] <= now;
+    return count;
+}
+
+int64_t snapshot_view::staked_by_referral( uint64_t value ) const
+{
+    const uint64_t* refs = referral();
+    const int64_t* column = staked();
+    int64_t total = 0;
+    for ( uint64_t i = 0; i < size(); ++i ) total += refs[i] == value ? column[i] : 0;
+    return total;
+}
+
+uint64_t snapshot_view::count_reward_holders( uint64_t sym_code ) const
+{
+    for ( uint32_t r = 0; r < _header->reward_count; ++r ) {
+        if ( ( rewards()[r].symbol >> 8 ) != sym_code ) continue;
+        const uint64_t bit = 1ULL << r;
+        const uint64_t* masks = reward_mask();
+        uint64_t count = 0;
+        for ( uint64_t i = 0; i < size(); ++i ) count += ( masks[i] & bit ) != 0;
+        return count;
+    }
+    return 0;
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "rows.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * Columnar snapshot of the proxy contract tables (`.pxsnap`)
+ *
+ * Little-endian, every section 8-byte aligned so the file can be memory-mapped and read in place:
+ *
+ * | section               | type                  | count         |
+ * |-----------------------|-----------------------|---------------|
+ * | header                | `snapshot_header`     | 1             |
+ * | rewards dictionary    | `snapshot_reward`     | reward_count  |
+ * | owner                 | `uint64_t` (sorted)   | voter_count   |
+ * | staked                | `int64_t`             | voter_count   |
+ * | next_claim_period     | `uint32_t`            | voter_count   |
+ * | referral              | `uint64_t`            | voter_count   |
+ * | reward mask           | `uint64_t`            | voter_count   |
+ * | portfolio offset      | `uint32_t`            | voter_count+1 |
+ * | portfolio reward      | `uint8_t` (dict index)| entry_count   |
+ * | portfolio percentage  | `uint16_t` (pips)     | entry_count   |
+ *
+ * Bit `i` of the reward mask is set when `voters.v2` `rewards` contains dictionary entry `i`.
+ * Symbols missing from the `rewards` dump (e.g. removed by `delreward`) are skipped and counted in `export_stats`.
+ * Voters without a `portfolio2` row have an empty portfolio range.
+ */
+static constexpr uint64_t SNAPSHOT_MAGIC = 0x313050414E535850ULL; // "PXSNAP01"
+static constexpr uint32_t SNAPSHOT_VERSION = 1;
+static constexpr uint32_t SNAPSHOT_MAX_REWARDS = 64;
+
+struct snapshot_header {
+    uint64_t    magic = SNAPSHOT_MAGIC;
+    uint32_t    version = SNAPSHOT_VERSION;
+    uint32_t    reward_count = 0;
+    uint64_t    voter_count = 0;
+    uint64_t    entry_count = 0;
+    uint64_t    owner_offset = 0;
+    uint64_t    staked_offset = 0;
+    uint64_t    next_claim_offset = 0;
+    uint64_t    referral_offset = 0;
+    uint64_t    reward_mask_offset = 0;
+    uint64_t    portfolio_index_offset = 0;
+    uint64_t    portfolio_reward_offset = 0;
+    uint64_t    portfolio_percentage_offset = 0;
+    uint64_t    file_size = 0;
+};
+
+struct snapshot_reward {
+    uint64_t    symbol = 0;
+    uint64_t    contract = 0;
+    int64_t     price_amount = 0;
+    uint64_t    price_symbol = 0;
+};
+
+struct export_stats {
+    uint64_t    voters = 0;
+    uint64_t    portfolios = 0;
+    uint64_t    entries = 0;
+    uint64_t    unknown_rewards = 0;
+    uint64_t    bytes = 0;
+};
+
+/**
+ * Collects rows (in any order) and writes the columnar file
+ */
+class snapshot_writer {
+public:
+    void add_reward( const reward_row& row );
+    void add_voter( voter_row row );
+    void add_portfolio( portfolio_row row );
+
+    export_stats write( const std::string& path );
+
+private:
+    std::vector<reward_row>     _rewards;
+    std::vector<voter_row>      _voters;
+    std::vector<portfolio_row>  _portfolios;
+
+    // dictionary index of `sym_code`, -1 if the rewards dump does not list it
+    int32_t reward_index( uint64_t sym_code ) const;
+};
+
+/**
+ * Read-only memory-mapped view of a `.pxsnap` file
+ */
+class snapshot_view {
+public:
+    explicit snapshot_view( const std::string& path );
+    ~snapshot_view();
+
+    snapshot_view( const snapshot_view& ) = delete;
+    snapshot_view& operator=( const snapshot_view& ) = delete;
+
+    const snapshot_header& header() const { return *_header; }
+    uint64_t size() const { return _header->voter_count; }
+
+    const snapshot_reward* rewards() const { return at<snapshot_reward>( sizeof( snapshot_header ) ); }
+    const uint64_t* owner() const { return at<uint64_t>( _header->owner_offset ); }
+    const int64_t* staked() const { return at<int64_t>( _header->staked_offset ); }
+    const uint32_t* next_claim_period() const { return at<uint32_t>( _header->next_claim_offset ); }
+    const uint64_t* referral() const { return at<uint64_t>( _header->referral_offset ); }
+    const uint64_t* reward_mask() const { return at<uint64_t>( _header->reward_mask_offset ); }
+    const uint32_t* portfolio_index() const { return at<uint32_t>( _header->portfolio_index_offset ); }
+    const uint8_t* portfolio_reward() const { return at<uint8_t>( _header->portfolio_reward_offset ); }
+    const uint16_t* portfolio_percentage() const { return at<uint16_t>( _header->portfolio_percentage_offset ); }
+
+    // row index of `owner` (binary search), or -1
+    int64_t find( uint64_t owner ) const;
+
+    // aggregates
+    int64_t total_staked() const;
+    uint64_t count_due( uint32_t now ) const;
+    int64_t staked_by_referral( uint64_t referral ) const;
+    uint64_t count_reward_holders( uint64_t sym_code ) const;
+
+private:
+    const uint8_t*          _data = nullptr;
+    size_t                  _size = 0;
+    const snapshot_header*  _header = nullptr;
+
+    template <typename T>
+    const T* at( uint64_t offset ) const { return reinterpret_cast<const T*>( _data + offset ); }
+};
+
+} // namespace proxy_tools
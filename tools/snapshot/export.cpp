@@ -0,0 +1,16 @@
+#include "export.hpp"
+
+namespace proxy_tools {
+
+export_stats export_snapshot( const export_paths& paths )
+{
+    snapshot_writer writer;
+    read_dump( paths.rewards, [&]( const json& row ) { writer.add_reward( parse_reward( row ) ); } );
+    read_dump( paths.voters, [&]( const json& row ) { writer.add_voter( parse_voter( row ) ); } );
+    if ( !paths.portfolio.empty() ) {
+        read_dump( paths.portfolio, [&]( const json& row ) { writer.add_portfolio( parse_portfolio( row ) ); } );
+    }
+    return writer.write( paths.output );
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "columnar.hpp"
+
+#include <string>
+
+namespace proxy_tools {
+
+struct export_paths {
+    std::string     rewards;        // `rewards` table dump
+    std::string     voters;         // `voters.v2` table dump
+    std::string     portfolio;      // `portfolio2` table dump (optional)
+    std::string     output;         // `.pxsnap` file
+};
+
+// reads the table dumps and writes the columnar snapshot
+export_stats export_snapshot( const export_paths& paths );
+
+} // namespace proxy_tools
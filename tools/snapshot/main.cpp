@@ -0,0 +1,66 @@
+#include "export.hpp"
+
+#include <ctime>
+#include <iostream>
+
+using namespace proxy_tools;
+
+namespace {
+
+void usage()
+{
+    std::cerr <<
+        "usage: proxy-snapshot export --rewards <dump> --voters <dump> [--portfolio <dump>] -o <file.pxsnap>\n"
+        "       proxy-snapshot stats <file.pxsnap> [--now <2019-08-07T18:37:37>] [--referral <name>] [--reward <SYM>]\n"
+        "\n"
+        "Dumps are `get_table_rows` output (JSON or hex rows with \"json\": false), one page or row per line.\n";
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    if ( argc < 3 ) { usage(); return 1; }
+    const std::string command = argv[1];
+
+    try {
+        if ( command == "export" ) {
+            export_paths paths;
+            for ( int i = 2; i + 1 < argc; i += 2 ) {
+                const std::string arg = argv[i];
+                if ( arg == "--rewards" ) paths.rewards = argv[i + 1];
+                else if ( arg == "--voters" ) paths.voters = argv[i + 1];
+                else if ( arg == "--portfolio" ) paths.portfolio = argv[i + 1];
+                else if ( arg == "-o" || arg == "--output" ) paths.output = argv[i + 1];
+                else { usage(); return 1; }
+            }
+            if ( paths.rewards.empty() || paths.voters.empty() || paths.output.empty() ) { usage(); return 1; }
+
+            const export_stats stats = export_snapshot( paths );
+            std::cout << "voters=" << stats.voters << " portfolios=" << stats.portfolios
+                      << " entries=" << stats.entries << " unknown_rewards=" << stats.unknown_rewards
+                      << " bytes=" << stats.bytes << std::endl;
+            return 0;
+        }
+
+        if ( command == "stats" ) {
+            snapshot_view view( argv[2] );
+            uint32_t now = static_cast<uint32_t>( std::time( nullptr ) );
+            for ( int i = 3; i + 1 < argc; i += 2 ) {
+                const std::string arg = argv[i];
+                if ( arg == "--now" ) now = string_to_time_point_sec( argv[i + 1] );
+                else if ( arg == "--referral" ) std::cout << "staked_by_referral=" << view.staked_by_referral( string_to_name( argv[i + 1] ) ) << std::endl;
+                else if ( arg == "--reward" ) std::cout << "reward_holders=" << view.count_reward_holders( string_to_symbol_code( argv[i + 1] ) ) << std::endl;
+                else { usage(); return 1; }
+            }
+            std::cout << "voters=" << view.size() << " portfolio_entries=" << view.header().entry_count
+                      << " total_staked=" << view.total_staked() << " due=" << view.count_due( now ) << std::endl;
+            return 0;
+        }
+    } catch ( const std::exception& e ) {
+        std::cerr << "proxy-snapshot: " << e.what() << std::endl;
+        return 1;
+    }
+    usage();
+    return 1;
+}
@@ -0,0 +1,174 @@
+#include "rows.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace proxy_tools {
+
+void unpacker::need( size_t n )
+{
+    if ( _pos + n > _size ) throw std::runtime_error( "unpack: row truncated" );
+}
+
+uint8_t unpacker::u8()
+{
+    need( 1 );
+    return _data[_pos++];
+}
+
+uint32_t unpacker::u32()
+{
+    need( 4 );
+    uint32_t value = 0;
+    for ( int i = 0; i < 4; ++i ) value |= static_cast<uint32_t>( _data[_pos++] ) << ( 8 * i );
+    return value;
+}
+
+uint64_t unpacker::u64()
+{
+    need( 8 );
+    uint64_t value = 0;
+    for ( int i = 0; i < 8; ++i ) value |= static_cast<uint64_t>( _data[_pos++] ) << ( 8 * i );
+    return value;
+}
+
+uint32_t unpacker::varuint32()
+{
+    uint32_t value = 0;
+    for ( int shift = 0; shift < 35; shift += 7 ) {
+        const uint8_t b = u8();
+        value |= static_cast<uint32_t>( b & 0x7F ) << shift;
+        if ( !( b & 0x80 ) ) return value;
+    }
+    throw std::runtime_error( "unpack: invalid varuint32" );
+}
+
+voter_row unpack_voter( const uint8_t* data, size_t size )
+{
+    unpacker in( data, size );
+    voter_row row;
+    row.owner = in.u64();
+    row.next_claim_period = in.u32();
+    row.staked = in.i64();
+    row.referral = in.u64();
+    for ( uint32_t n = in.varuint32(); n > 0; --n ) row.rewards.push_back( in.u64() );
+    for ( uint32_t n = in.varuint32(); n > 0; --n ) {
+        const uint64_t key = in.u64();
+        row.protocol_features.emplace_back( key, in.u8() != 0 );
+    }
+    return row;
+}
+
+portfolio_row unpack_portfolio( const uint8_t* data, size_t size )
+{
+    unpacker in( data, size );
+    portfolio_row row;
+    row.owner = in.u64();
+    for ( uint32_t n = in.varuint32(); n > 0; --n ) row.rewards.push_back( in.u64() );
+    for ( uint32_t n = in.varuint32(); n > 0; --n ) row.percentages.push_back( in.i64() );
+    return row;
+}
+
+reward_row unpack_reward( const uint8_t* data, size_t size )
+{
+    unpacker in( data, size );
+    reward_row row;
+    row.symbol = in.u64();
+    row.contract = in.u64();
+    row.price.amount = in.i64();
+    row.price.symbol = in.u64();
+    return row;
+}
+
+static std::vector<uint8_t> hex_row( const json& row )
+{
+    return from_hex( row.is_string() ? row.as_string() : row["data"].as_string() );
+}
+
+static bool is_binary( const json& row )
+{
+    return row.is_string() || ( row.is_object() && row.contains( "data" ) && row["data"].is_string() );
+}
+
+voter_row parse_voter( const json& row )
+{
+    if ( is_binary( row ) ) {
+        const std::vector<uint8_t> data = hex_row( row );
+        return unpack_voter( data.data(), data.size() );
+    }
+    voter_row result;
+    result.owner = string_to_name( row["owner"].as_string() );
+    result.next_claim_period = string_to_time_point_sec( row["next_claim_period"].as_string() );
+    result.staked = row["staked"].as_int64();
+    result.referral = string_to_name( row["referral"].as_string() );
+    for ( const json& sym : row["rewards"].items() ) result.rewards.push_back( string_to_symbol_code( sym.as_string() ) );
+    if ( row.contains( "protocol_features" ) ) {
+        for ( const json& feature : row["protocol_features"].items() ) {
+            result.protocol_features.emplace_back( string_to_name( feature["key"].as_string() ), feature["value"].as_bool() );
+        }
+    }
+    return result;
+}
+
+portfolio_row parse_portfolio( const json& row )
+{
+    if ( is_binary( row ) ) {
+        const std::vector<uint8_t> data = hex_row( row );
+        return unpack_portfolio( data.data(), data.size() );
+    }
+    portfolio_row result;
+    result.owner = string_to_name( row["owner"].as_string() );
+    for ( const json& sym : row["rewards"].items() ) result.rewards.push_back( string_to_symbol_code( sym.as_string() ) );
+    for ( const json& pct : row["percentages"].items() ) result.percentages.push_back( pct.as_int64() );
+    return result;
+}
+
+reward_row parse_reward( const json& row )
+{
+    if ( is_binary( row ) ) {
+        const std::vector<uint8_t> data = hex_row( row );
+        return unpack_reward( data.data(), data.size() );
+    }
+    // symbol is "4,EOS"
+    const std::string sym = row["symbol"].as_string();
+    const size_t comma = sym.find( ',' );
+    reward_row result;
+    result.symbol = ( string_to_symbol_code( sym.substr( comma + 1 ) ) << 8 ) | std::stoul( sym.substr( 0, comma ) );
+    result.contract = string_to_name( row["contract"].as_string() );
+    result.price = string_to_asset( row["price"].as_string() );
+    return result;
+}
+
+static void emit( const json& value, const std::function<void( const json& )>& callback )
+{
+    if ( value.is_object() && value.contains( "rows" ) ) {
+        for ( const json& row : value["rows"].items() ) callback( row );
+    } else if ( value.is_array() ) {
+        for ( const json& row : value.items() ) callback( row );
+    } else {
+        callback( value );
+    }
+}
+
+void read_dump( const std::string& path, const std::function<void( const json& )>& callback )
+{
+    std::ifstream file( path, std::ios::binary );
+    if ( !file ) throw std::runtime_error( "dump: cannot open " + path );
+
+    // one JSON value per line; a pretty-printed single document is accumulated until it parses
+    std::string line, pending;
+    while ( std::getline( file, line ) ) {
+        if ( pending.empty() && line.find_first_not_of( " \t\r" ) == std::string::npos ) continue;
+        if ( pending.empty() ) {
+            try {
+                emit( json::parse( line ), callback );
+                continue;
+            } catch ( const json_error& ) {}
+        }
+        pending += line;
+        pending += '\n';
+    }
+    if ( pending.find_first_not_of( " \t\r\n" ) != std::string::npos ) emit( json::parse( pending ), callback );
+}
+
+} // namespace proxy_tools
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../common/eosio.hpp"
+#include "../common/json.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace proxy_tools {
+
+/**
+ * Host mirrors of the `proxy.hpp` rows read by the exporter
+ *
+ * Field order matches the contract structs, so binary rows (`get_table_rows` with `"json": false`) decode in place.
+ */
+struct voter_row {                                          // proxy::voters_v2_row
+    uint64_t                            owner = 0;
+    uint32_t                            next_claim_period = 0;
+    int64_t                             staked = 0;
+    uint64_t                            referral = 0;
+    std::vector<uint64_t>               rewards;            // set<symbol_code>
+    std::vector<std::pair<uint64_t, bool>> protocol_features; // map<name, bool>
+};
+
+struct portfolio_row {                                      // proxy::portfolio2_row
+    uint64_t                owner = 0;
+    std::vector<uint64_t>   rewards;                        // vector<symbol_code>
+    std::vector<int64_t>    percentages;
+};
+
+struct reward_row {                                         // proxy::rewards_row
+    uint64_t    symbol = 0;
+    uint64_t    contract = 0;
+    asset       price;
+};
+
+class unpacker {
+public:
+    unpacker( const uint8_t* data, size_t size ) : _data( data ), _size( size ) {}
+
+    uint8_t u8();
+    uint32_t u32();
+    uint64_t u64();
+    int64_t i64() { return static_cast<int64_t>( u64() ); }
+    uint32_t varuint32();
+    bool done() const { return _pos == _size; }
+
+private:
+    const uint8_t*  _data;
+    size_t          _size;
+    size_t          _pos = 0;
+
+    void need( size_t n );
+};
+
+voter_row unpack_voter( const uint8_t* data, size_t size );
+portfolio_row unpack_portfolio( const uint8_t* data, size_t size );
+reward_row unpack_reward( const uint8_t* data, size_t size );
+
+// a row from a table dump: JSON object (`"json": true`) or hex string (`"json": false`)
+voter_row parse_voter( const json& row );
+portfolio_row parse_portfolio( const json& row );
+reward_row parse_reward( const json& row );
+
+/**
+ * Streams rows from a table dump file
+ *
+ * Accepts `get_table_rows` pages (`{"rows": [...], "more": ...}`) either as one document or one page per line,
+ * and JSON lines with one row per line.
+ */
+void read_dump( const std::string& path, const std::function<void( const json& )>& callback );
+
+} // namespace proxy_tools
@@ -0,0 +1,38 @@
+#include "test.hpp"
+
+#include "../common/eosio.hpp"
+#include "../common/json.hpp"
+
+using namespace proxy_tools;
+
+TEST_CASE( "name encoding round-trips" ) {
+    CHECK( string_to_name( "eosio" ) == 6138663577826885632ULL );
+    CHECK( name_to_string( string_to_name( "proxy4nation" ) ) == "proxy4nation" );
+    CHECK( name_to_string( string_to_name( "voters.v2" ) ) == "voters.v2" );
+    CHECK( string_to_name( "" ) == 0 );
+}
+
+TEST_CASE( "asset encoding round-trips" ) {
+    const asset eos = string_to_asset( "1.0000 EOS" );
+    CHECK( eos.amount == 10000 );
+    CHECK( eos.precision() == 4 );
+    CHECK( symbol_code_to_string( eos.code() ) == "EOS" );
+    CHECK( asset_to_string( eos ) == "1.0000 EOS" );
+    CHECK( asset_to_string( string_to_asset( "-0.0050 DAPP" ) ) == "-0.0050 DAPP" );
+    CHECK( asset_to_string( string_to_asset( "12 ABC" ) ) == "12 ABC" );
+}
+
+TEST_CASE( "time_point_sec round-trips" ) {
+    CHECK( string_to_time_point_sec( "1970-01-01T00:01:00" ) == 60 );
+    CHECK( time_point_sec_to_string( string_to_time_point_sec( "2019-08-07T18:37:37.500" ) ) == "2019-08-07T18:37:37" );
+}
+
+TEST_CASE( "json parses and dumps" ) {
+    const json value = json::parse( R"({"a":[1,"x\n",true,null,{"b":18446744073709551615}],"c":"é"})" );
+    CHECK( value["a"].size() == 5 );
+    CHECK( value["a"][4]["b"].as_uint64() == 18446744073709551615ULL );
+    CHECK( value["c"].as_string() == "\xc3\xa9" );
+    CHECK( value.dump() == "{\"a\":[1,\"x\\n\",true,null,{\"b\":18446744073709551615}],\"c\":\"\xc3\xa9\"}" );
+}
+
+TEST_MAIN()
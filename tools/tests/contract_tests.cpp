@@ -0,0 +1,353 @@
+#include "test.hpp"
+
+#include "../../proxy.hpp"
+#include "../merkle/epoch.hpp"
+#include "chain.hpp"
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using proxy_tools::test_chain;
+
+namespace {
+
+const name PROXY = "proxy4nation"_n;
+const name TOKEN = "eosio.token"_n;
+const name DAPP_TOKEN = "dappservices"_n;
+const uint32_t NOW = 1565136000; // 2019-08-07T00:00:00
+
+const symbol EOS = symbol{"EOS", 4};
+const symbol DAPP = symbol{"DAPP", 4};
+
+// public mirrors of the contract's private table typedefs
+typedef eosio::multi_index< "voters.v2"_n, proxy::voters_v2_row,
+    indexed_by<"bynextclaim"_n, const_mem_fun<proxy::voters_v2_row, uint64_t, &proxy::voters_v2_row::by_next_claim>>,
+    indexed_by<"byreferral"_n, const_mem_fun<proxy::voters_v2_row, uint64_t, &proxy::voters_v2_row::by_referral>>
+> voters_table;
+typedef eosio::multi_index< "rewards"_n, proxy::rewards_row > rewards_table;
+typedef eosio::multi_index< "portfolio2"_n, proxy::portfolio2_row > portfolio2_table;
+typedef eosio::multi_index< "proxies"_n, proxy::proxies_row > proxies_table;
+typedef eosio::multi_index< "treasury"_n, proxy::treasury_row > treasury_table;
+
+struct transfer {
+    name    contract;
+    name    to;
+    asset   quantity;
+};
+
+// one chain with `proxy4nation` registered as an active proxy & EOS / DAPP rewards
+struct fixture {
+    test_chain chain;
+
+    fixture()
+    {
+        chain.set_time( NOW );
+        for ( const name account : { PROXY, TOKEN, DAPP_TOKEN, "eosio"_n } ) chain.create_account( account );
+
+        chain.apply( PROXY, {}, [&] {
+            proxies_table proxies( PROXY, PROXY.value );
+            proxies.emplace( PROXY, [&]( auto& row ) { row.proxy = PROXY; row.active = true; } );
+        });
+        add_reward( EOS, TOKEN, asset{ 10000, EOS } );
+        add_reward( DAPP, DAPP_TOKEN, asset{ 50, EOS } );
+    }
+
+    template <typename F>
+    void action( F&& body, const std::vector<permission_level>& auths = { { PROXY, "active"_n } } )
+    {
+        chain.apply( PROXY, auths, [&] {
+            proxy contract( PROXY, PROXY, eosio::datastream<const char*>( nullptr, 0 ) );
+            body( contract );
+        });
+    }
+
+    void add_reward( const symbol sym, const name contract, const asset price )
+    {
+        action( [&]( proxy& contract_ ) { contract_.setreward( sym, contract, price ); } );
+    }
+
+    void set_balance( const name contract, const asset balance )
+    {
+        chain.apply( contract, {}, [&] {
+            eosio::token::accounts accounts( contract, PROXY.value );
+            const auto itr = accounts.find( balance.symbol.code().raw() );
+            if ( itr == accounts.end() ) accounts.emplace( contract, [&]( auto& row ) { row.balance = balance; } );
+            else accounts.modify( itr, same_payer, [&]( auto& row ) { row.balance = balance; } );
+        });
+    }
+
+    void add_voter( const name owner, const int64_t staked, const std::vector<symbol_code>& rewards = {}, const std::vector<int64_t>& percentages = {},
+                    const name referral = {}, const name voter_proxy = PROXY )
+    {
+        chain.create_account( owner );
+        chain.apply( "eosio"_n, {}, [&] {
+            eosiosystem::voters_table voters( "eosio"_n, "eosio"_n.value );
+            voters.emplace( owner, [&]( auto& row ) { row.owner = owner; row.proxy = voter_proxy; row.staked = staked; } );
+        });
+        chain.apply( PROXY, {}, [&] {
+            voters_table voters( PROXY, PROXY.value );
+            voters.emplace( PROXY, [&]( auto& row ) {
+                row.owner = owner;
+                row.next_claim_period = time_point_sec( NOW - 1 );
+                row.staked = staked;
+                row.referral = referral;
+            });
+            if ( rewards.empty() ) return;
+            portfolio2_table portfolio( PROXY, PROXY.value );
+            portfolio.emplace( PROXY, [&]( auto& row ) {
+                row.owner = owner;
+                row.rewards = rewards;
+                row.percentages = percentages;
+            });
+        });
+    }
+
+    std::vector<transfer> transfers() const
+    {
+        std::vector<transfer> result;
+        for ( const auto& act : chain.inline_actions() ) {
+            if ( act.name != "transfer"_n ) continue;
+            const auto data = act.data_as<std::tuple<name, name, asset, std::string>>();
+            result.push_back( { act.account, std::get<1>( data ), std::get<2>( data ) } );
+        }
+        return result;
+    }
+
+    bool has_voter( const name owner )
+    {
+        bool found = false;
+        chain.apply( PROXY, {}, [&] {
+            voters_table voters( PROXY, PROXY.value );
+            found = voters.find( owner.value ) != voters.end();
+        });
+        return found;
+    }
+
+    proxy::treasury_row treasury( const symbol_code sym_code )
+    {
+        proxy::treasury_row row;
+        chain.apply( PROXY, {}, [&] { row = treasury_table( PROXY, PROXY.value ).get( sym_code.raw() ); } );
+        return row;
+    }
+};
+
+// `eosio::check` message of a failed action, empty if it succeeded
+template <typename F>
+std::string error_of( F&& body )
+{
+    try {
+        body();
+    } catch ( const eosio::check_failure& e ) {
+        return e.what();
+    }
+    return "";
+}
+
+// `proxy-merkle` amounts as contract assets
+std::vector<asset> to_assets( const std::vector<proxy_tools::asset>& amounts )
+{
+    std::vector<asset> result;
+    for ( const auto& amount : amounts ) result.push_back( asset{ amount.amount, symbol{ amount.symbol } } );
+    return result;
+}
+
+// README reward formula for a full day at the default 1.85% APR
+int64_t daily_amount( const int64_t staked, const int64_t percentage, const int64_t price )
+{
+    return static_cast<int64_t>( staked * 185 / 10000.0 / 365.0 * percentage / 10000.0 / ( 86400.0 / 86400 ) * ( 10000.0 / price ) );
+}
+
+} // namespace
+
+TEST_CASE( "claimall pays a batch against the running treasury balance" ) {
+    fixture t;
+    const int64_t staked = 10000000000;
+    const int64_t dapp = daily_amount( staked, 10000, 50 );
+    for ( const name owner : { "voter.a"_n, "voter.b"_n, "voter.c"_n } ) t.add_voter( owner, staked, { DAPP.code() }, { 10000 } );
+
+    // enough DAPP for two voters, the third is redirected to EOS at the DAPP price
+    const asset dapp_balance = asset{ dapp * 5 / 2, DAPP };
+    t.set_balance( DAPP_TOKEN, dapp_balance );
+    t.set_balance( TOKEN, asset{ 1000000000, EOS } );
+    t.action( []( proxy& contract ) { contract.claimall( binary_extension<uint64_t>{} ); } );
+
+    const auto transfers = t.transfers();
+    CHECK( transfers.size() == 3 );
+    CHECK( transfers[0].contract == DAPP_TOKEN && transfers[0].to == "voter.a"_n && transfers[0].quantity == asset( dapp, DAPP ) );
+    CHECK( transfers[1].contract == DAPP_TOKEN && transfers[1].to == "voter.b"_n && transfers[1].quantity == asset( dapp, DAPP ) );
+    CHECK( transfers[2].contract == TOKEN && transfers[2].to == "voter.c"_n && transfers[2].quantity == asset( dapp * 50 / 10000, EOS ) );
+
+    // treasury rows hold the balance left after the batch, not the balance the action started with
+    const auto row = t.treasury( DAPP.code() );
+    CHECK( row.balance.quantity == dapp_balance - asset( 2 * dapp, DAPP ) );
+    CHECK( row.paid == asset( 2 * dapp, DAPP ) );
+    CHECK( t.treasury( EOS.code() ).balance.quantity == asset( 1000000000 - dapp * 50 / 10000, EOS ) );
+}
+
+TEST_CASE( "claimall skips payouts once both the token and EOS treasuries run dry" ) {
+    fixture t;
+    const int64_t staked = 10000000000;
+    const int64_t eos = daily_amount( staked, 10000, 10000 );
+    for ( const name owner : { "voter.a"_n, "voter.b"_n, "voter.c"_n } ) t.add_voter( owner, staked );
+
+    t.set_balance( TOKEN, asset{ eos * 2, EOS } );
+    t.action( []( proxy& contract ) { contract.claimall( binary_extension<uint64_t>{} ); } );
+
+    const auto transfers = t.transfers();
+    CHECK( transfers.size() == 2 );
+    CHECK( t.treasury( EOS.code() ).balance.quantity == asset( 0, EOS ) );
+
+    // the unpaid voter still moves to the next period, with an empty receipt
+    t.chain.apply( PROXY, {}, [&] {
+        voters_table voters( PROXY, PROXY.value );
+        CHECK( voters.get( "voter.c"_n.value ).next_claim_period == time_point_sec( NOW + 86400 ) );
+    });
+}
+
+TEST_CASE( "claimall signs out voters who no longer proxy to a registered proxy" ) {
+    fixture t;
+    const int64_t staked = 10000000000;
+    t.add_voter( "voter.a"_n, staked, { DAPP.code() }, { 10000 }, {}, "other"_n );
+    t.add_voter( "voter.b"_n, staked );
+    t.set_balance( TOKEN, asset{ 1000000000, EOS } );
+    t.action( []( proxy& contract ) { contract.claimall( binary_extension<uint64_t>{} ); } );
+
+    const auto transfers = t.transfers();
+    CHECK( transfers.size() == 1 && transfers[0].to == "voter.b"_n );
+    CHECK( !t.has_voter( "voter.a"_n ) );
+    t.chain.apply( PROXY, {}, [&] {
+        portfolio2_table portfolio( PROXY, PROXY.value );
+        CHECK( portfolio.find( "voter.a"_n.value ) == portfolio.end() );
+    });
+}
+
+TEST_CASE( "claimall moves voters of an inactive proxy to the next period unpaid" ) {
+    fixture t;
+    t.add_voter( "voter.a"_n, 10000000000 );
+    t.set_balance( TOKEN, asset{ 1000000000, EOS } );
+    t.chain.apply( PROXY, {}, [&] {
+        proxies_table proxies( PROXY, PROXY.value );
+        proxies.modify( proxies.get( PROXY.value ), same_payer, [&]( auto& row ) { row.active = false; } );
+    });
+    t.action( []( proxy& contract ) { contract.claimall( binary_extension<uint64_t>{} ); } );
+
+    CHECK( t.transfers().empty() );
+    t.chain.apply( PROXY, {}, [&] {
+        voters_table voters( PROXY, PROXY.value );
+        CHECK( voters.get( "voter.a"_n.value ).next_claim_period == time_point_sec( NOW + 86400 ) );
+    });
+}
+
+TEST_CASE( "claimref pays the referral share from the running treasury balance" ) {
+    fixture t;
+    const name referral = "tokenyieldio"_n;
+    const int64_t staked = 10000000000;
+    const int64_t eos = daily_amount( staked, 10000, 10000 );
+    const int64_t share = eos * 500 / 10000;
+    t.chain.create_account( referral );
+    t.add_voter( "ref.a"_n, staked, {}, {}, referral );
+    t.add_voter( "ref.b"_n, staked, {}, {}, referral, "other"_n );
+    t.add_voter( "ref.c"_n, staked, {}, {}, referral );
+
+    // enough EOS for both voters & one referral share
+    t.set_balance( TOKEN, asset{ 2 * eos + share, EOS } );
+    t.action( [&]( proxy& contract ) { contract.claimref( referral, binary_extension<uint64_t>{} ); }, { { referral, "active"_n } } );
+
+    // ref.b is signed out mid-scan without breaking the `byreferral` walk
+    const auto transfers = t.transfers();
+    CHECK( transfers.size() == 3 );
+    CHECK( transfers[0].to == "ref.a"_n && transfers[0].quantity == asset( eos, EOS ) );
+    CHECK( transfers[1].to == referral && transfers[1].quantity == asset( share, EOS ) );
+    CHECK( transfers[2].to == "ref.c"_n && transfers[2].quantity == asset( eos, EOS ) );
+    CHECK( !t.has_voter( "ref.b"_n ) );
+    CHECK( t.treasury( EOS.code() ).balance.quantity == asset( 0, EOS ) );
+    CHECK( t.treasury( EOS.code() ).paid == asset( 2 * eos + share, EOS ) );
+}
+
+TEST_CASE( "one epoch pays every token of a period with a single proof" ) {
+    fixture t;
+    const int64_t staked = 10000000000;
+    const time_point_sec period = time_point_sec( NOW - 1 );
+    t.add_voter( "voter.a"_n, staked, { DAPP.code(), EOS.code() }, { 5000, 5000 } );
+    t.add_voter( "voter.b"_n, staked );
+    t.set_balance( DAPP_TOKEN, asset{ 100000000000, DAPP } );
+    t.set_balance( TOKEN, asset{ 1000000000, EOS } );
+
+    // leaves built off-chain by `proxy-merkle` from the same rows
+    const std::vector<proxy_tools::reward_row> rewards = {
+        { EOS.raw(), TOKEN.value, { 10000, EOS.raw() } },
+        { DAPP.raw(), DAPP_TOKEN.value, { 50, EOS.raw() } },
+    };
+    const std::vector<proxy_tools::voter_row> voters = {
+        { "voter.a"_n.value, period.sec_since_epoch(), staked },
+        { "voter.b"_n.value, period.sec_since_epoch(), staked },
+    };
+    std::unordered_map<uint64_t, proxy_tools::portfolio_row> portfolios;
+    portfolios["voter.a"_n.value] = { "voter.a"_n.value, { DAPP.code().raw(), EOS.code().raw() }, { 5000, 5000 } };
+    const proxy_tools::epoch_result epoch = proxy_tools::build_epoch( rewards, voters, portfolios, { period.sec_since_epoch(), 185, 86400 } );
+    const proxy_tools::merkle_tree tree = proxy_tools::build_tree( epoch.leaves );
+
+    std::vector<extended_asset> totals;
+    for ( size_t i = 0; i < epoch.totals.size(); ++i ) totals.push_back( extended_asset{ to_assets( { epoch.totals[i] } )[0], name{ epoch.contracts[i] } } );
+    CHECK( totals.size() == 2 && totals[0].quantity.symbol == EOS && totals[1].quantity.symbol == DAPP );
+
+    const auto set_epoch = [&]( const uint64_t id, const std::vector<extended_asset>& totals_ ) {
+        t.action( [&]( proxy& contract ) { contract.setepoch( id, checksum256{ epoch.root }, totals_, epoch.leaves.size(), period, time_point_sec( NOW + 30 * 86400 ) ); } );
+    };
+    const auto claim_proof = [&]( const uint64_t id, const uint64_t index ) {
+        std::vector<checksum256> proof;
+        for ( const auto& sibling : tree.proof( index ) ) proof.push_back( checksum256{ sibling } );
+        const name owner{ epoch.leaves[index].owner };
+        t.action( [&]( proxy& contract ) { contract.claimproof( owner, id, index, to_assets( epoch.leaves[index].amounts ), proof ); }, { { owner, "active"_n } } );
+    };
+    CHECK( error_of( [&] { set_epoch( 1, { totals[1], totals[0] } ); } ) == "proxy::setepoch: totals must be sorted by symbol code without duplicates" );
+    set_epoch( 1, totals );
+
+    // voter.a is paid both portfolio tokens by one claim & moves to the next period once
+    claim_proof( 1, 0 );
+    const auto transfers = t.transfers();
+    CHECK( transfers.size() == 2 );
+    CHECK( transfers[0].contract == TOKEN && transfers[0].quantity == asset( daily_amount( staked, 5000, 10000 ), EOS ) );
+    CHECK( transfers[1].contract == DAPP_TOKEN && transfers[1].quantity == asset( daily_amount( staked, 5000, 50 ), DAPP ) );
+    t.chain.apply( PROXY, {}, [&] {
+        voters_table voters_( PROXY, PROXY.value );
+        CHECK( voters_.get( "voter.a"_n.value ).next_claim_period == period + 86400 );
+    });
+    CHECK( t.treasury( DAPP.code() ).paid == asset( daily_amount( staked, 5000, 50 ), DAPP ) );
+
+    claim_proof( 1, 1 );
+    CHECK( t.transfers().size() == 1 && t.transfers()[0].quantity == asset( daily_amount( staked, 10000, 10000 ), EOS ) );
+
+    // a period is paid once, a second root for it cannot be claimed again
+    set_epoch( 2, totals );
+    CHECK( error_of( [&] { claim_proof( 2, 0 ); } ) == "proxy::claimproof: claim period already paid" );
+}
+
+TEST_CASE( "payforcpu only meters the contract's own CPU" ) {
+    fixture t;
+    const name owner = "myaccount"_n;
+    const name eve = "eve"_n;
+    t.chain.create_account( eve );
+
+    transaction trx;
+    trx.actions.emplace_back( permission_level{ PROXY, "payforcpu"_n }, PROXY, "payforcpu"_n, std::make_tuple( std::optional<permission_level>{} ) );
+    trx.actions.emplace_back( permission_level{ owner, "active"_n }, PROXY, "claim"_n, std::make_tuple( owner ) );
+    t.chain.set_transaction( eosio::pack( trx ) );
+
+    // a third-party payer would spend the owner's quota on CPU it pays itself
+    const permission_level other{ eve, "active"_n };
+    CHECK( error_of( [&] { t.action( [&]( proxy& contract ) { contract.payforcpu( other ); }, { other } ); } ) == "proxy::payforcpu: payer must be proxy4nation" );
+
+    const permission_level sponsor{ PROXY, "payforcpu"_n };
+    for ( int i = 0; i < 2; ++i ) t.action( [&]( proxy& contract ) { contract.payforcpu( std::nullopt ); }, { sponsor } );
+    t.action( [&]( proxy& contract ) { contract.payforcpu( permission_level{ PROXY, "active"_n } ); } );
+
+    t.chain.apply( PROXY, {}, [&] {
+        eosio::multi_index< "sponsored"_n, proxy::sponsored_row > sponsored( PROXY, PROXY.value );
+        CHECK( sponsored.get( owner.value ).priority_count == 3 );
+    });
+}
+
+TEST_MAIN()
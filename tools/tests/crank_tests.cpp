@@ -0,0 +1,218 @@
+#include "mock_rpc.hpp"
+#include "test.hpp"
+
+#include "../crank/crank.hpp"
+
+#include <cstring>
+#include <mutex>
+
+using namespace proxy_tools;
+using namespace proxy_tools::test;
+
+namespace {
+
+// in-memory chain answering the RPC calls made by the crank
+struct mock_chain {
+    std::mutex      lock;
+    uint64_t        due = 0;
+    uint64_t        base_cpu_us = 200;
+    uint64_t        voter_cpu_us = 400;
+    uint64_t        deadline_us = 150000;
+    uint32_t        pushed = 0;
+    uint32_t        failed = 0;
+    uint64_t        last_limit = 0;
+
+    std::pair<int, std::string> handle( const std::string& path, const std::string& body )
+    {
+        std::lock_guard<std::mutex> guard( lock );
+        if ( path == "/v1/chain/get_info" ) {
+            return { 200, R"({"chain_id":"aca376f206b8fc25a6ed44dbdc66547c36c6c33e3a119ffbeaef943642f0e906","head_block_num":1000,"head_block_time":"2019-08-07T18:37:37.500","head_block_id":"000003e8aabbccdd11223344556677889900aabbccddeeff0011223344556677"})" };
+        }
+        if ( path == "/v1/chain/get_table_rows" ) {
+            const json request = json::parse( body );
+            json rows = json::array();
+            if ( request.contains( "upper_bound" ) ) {
+                const uint64_t count = std::min<uint64_t>( due, request["limit"].as_uint64() );
+                for ( uint64_t i = 0; i < count; ++i ) {
+                    json row = json::object();
+                    row["owner"] = "voter";
+                    row["next_claim_period"] = "2019-08-07T00:00:00";
+                    rows.push_back( row );
+                }
+            }
+            json reply = json::object();
+            reply["rows"] = rows;
+            reply["more"] = false;
+            return { 200, reply.dump() };
+        }
+        if ( path == "/v1/wallet/get_public_keys" ) return { 200, R"(["EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV"])" };
+        if ( path == "/v1/chain/get_required_keys" ) return { 200, R"({"required_keys":["EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV"]})" };
+        if ( path == "/v1/wallet/sign_transaction" ) return { 200, R"({"signatures":["SIG_K1_mock"]})" };
+        if ( path == "/v1/chain/push_transaction" ) {
+            ++pushed;
+            const std::vector<uint8_t> packed = from_hex( json::parse( body )["packed_trx"].as_string() );
+            uint64_t limit = 0;
+            std::memcpy( &limit, packed.data() + 49, sizeof( limit ) );
+            last_limit = limit;
+
+            const uint64_t claimed = std::min( limit, due );
+            const uint64_t cpu = base_cpu_us + voter_cpu_us * claimed;
+            if ( cpu > deadline_us ) {
+                ++failed;
+                return { 500, R"({"code":500,"error":{"name":"deadline_exception","details":[{"message":"deadline exceeded"}]}})" };
+            }
+            due -= claimed;
+
+            json receipts = json::array();
+            for ( uint64_t i = 0; i < claimed; ++i ) {
+                // `receipt` notifies the owner, the notification trace must not be counted as a claim
+                json notification = json::object();
+                notification["receiver"] = "myaccount";
+                notification["act"]["account"] = "proxy4nation";
+                notification["act"]["name"] = "receipt";
+
+                json trace = json::object();
+                trace["receiver"] = "proxy4nation";
+                trace["act"]["account"] = "proxy4nation";
+                trace["act"]["name"] = "receipt";
+                trace["inline_traces"].push_back( notification );
+                receipts.push_back( trace );
+            }
+            json claimall = json::object();
+            claimall["receiver"] = "proxy4nation";
+            claimall["act"]["account"] = "proxy4nation";
+            claimall["act"]["name"] = "claimall";
+            claimall["inline_traces"] = receipts;
+
+            json reply = json::object();
+            reply["transaction_id"] = "abc";
+            reply["processed"]["receipt"]["cpu_usage_us"] = cpu;
+            reply["processed"]["action_traces"].push_back( claimall );
+            return { 202, reply.dump() };
+        }
+        return { 404, R"({"code":404})" };
+    }
+};
+
+} // namespace
+
+TEST_CASE( "batch_controller grows toward target cpu" ) {
+    batch_config config;
+    config.initial_limit = 50;
+    config.target_cpu_us = 100000;
+    batch_controller controller( config );
+
+    controller.on_success( 50, 50 * 400 );
+    CHECK( controller.limit() == 100 );
+    controller.on_success( 100, 100 * 400 );
+    CHECK( controller.limit() == 200 );
+    controller.on_success( 200, 200 * 400 );
+    CHECK( controller.limit() == 250 );
+    controller.on_success( 250, 250 * 400 );
+    CHECK( controller.limit() == 250 );
+}
+
+TEST_CASE( "batch_controller halves on deadline and backs off" ) {
+    batch_config config;
+    config.initial_limit = 400;
+    batch_controller controller( config );
+
+    controller.on_failure( true );
+    CHECK( controller.limit() == 200 );
+    CHECK( controller.backoff() == config.backoff_initial );
+    controller.on_failure( false );
+    CHECK( controller.limit() == 200 );
+    CHECK( controller.backoff() == config.backoff_initial * 2 );
+    controller.on_success( 10, 1000 );
+    CHECK( controller.backoff().count() == 0 );
+}
+
+TEST_CASE( "batch_controller inflight bounded by due voters" ) {
+    batch_config config;
+    config.initial_limit = 50;
+    config.max_inflight = 4;
+    batch_controller controller( config );
+
+    CHECK( controller.inflight( 0 ) == 0 );
+    CHECK( controller.inflight( 1 ) == 1 );
+    CHECK( controller.inflight( 101 ) == 3 );
+    CHECK( controller.inflight( 10000 ) == 4 );
+}
+
+TEST_CASE( "claimall transaction packs limit as action data" ) {
+    chain_info info;
+    info.head_block_time = 1565202000;
+    info.ref_block_num = 1000;
+    info.ref_block_prefix = 0x44332211;
+
+    const crank_config config;
+    const transaction trx = crank::claimall_transaction( config, info, 123, 2 );
+    CHECK( trx.expiration == 1565202000 + 60 + 2 );
+
+    const std::vector<uint8_t> packed = trx.pack();
+    CHECK( packed.size() == 57 + 1 );
+    uint64_t limit = 0;
+    std::memcpy( &limit, packed.data() + 49, sizeof( limit ) );
+    CHECK( limit == 123 );
+}
+
+TEST_CASE( "crank drains due voters with adaptive batches" ) {
+    mock_chain chain;
+    chain.due = 2000;
+    mock_rpc_server server( [&]( const std::string& path, const std::string& body ) { return chain.handle( path, body ); } );
+
+    crank_config config;
+    config.batch.initial_limit = 50;
+    config.batch.target_cpu_us = 100000;
+    chain_rpc rpc( server.url(), server.url() );
+    crank runner( rpc, config );
+
+    uint64_t claimed = 0;
+    for ( int cycle = 0; cycle < 20 && chain.due > 0; ++cycle ) claimed += runner.run_once().claimed;
+
+    CHECK( chain.due == 0 );
+    CHECK( claimed == 2000 );
+    CHECK( chain.failed == 0 );
+    CHECK( runner.controller().limit() >= 240 && runner.controller().limit() <= 250 );
+    CHECK( chain.pushed <= 14 );
+}
+
+TEST_CASE( "crank shrinks batch after cpu deadline" ) {
+    mock_chain chain;
+    chain.due = 1000;
+    chain.base_cpu_us = 0;
+    chain.voter_cpu_us = 1000;
+    mock_rpc_server server( [&]( const std::string& path, const std::string& body ) { return chain.handle( path, body ); } );
+
+    crank_config config;
+    config.batch.initial_limit = 300;
+    config.batch.max_inflight = 1;
+    config.batch.target_cpu_us = 100000;
+    chain_rpc rpc( server.url(), server.url() );
+    crank runner( rpc, config );
+
+    const cycle_stats first = runner.run_once();
+    CHECK( first.failed == 1 );
+    CHECK( runner.controller().limit() == 150 );
+    CHECK( runner.controller().backoff().count() > 0 );
+
+    for ( int cycle = 0; cycle < 20 && chain.due > 0; ++cycle ) runner.run_once();
+    CHECK( chain.due == 0 );
+    CHECK( chain.failed == 1 );
+    CHECK( chain.last_limit <= 100 );
+}
+
+TEST_CASE( "crank is idle when nothing is due" ) {
+    mock_chain chain;
+    mock_rpc_server server( [&]( const std::string& path, const std::string& body ) { return chain.handle( path, body ); } );
+
+    chain_rpc rpc( server.url(), server.url() );
+    crank runner( rpc, crank_config{} );
+
+    const cycle_stats stats = runner.run_once();
+    CHECK( stats.due == 0 );
+    CHECK( stats.pushed == 0 );
+    CHECK( chain.pushed == 0 );
+}
+
+TEST_MAIN()
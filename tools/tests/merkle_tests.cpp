@@ -0,0 +1,150 @@
+#include "test.hpp"
+
+#include "../merkle/epoch.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace proxy_tools;
+
+namespace {
+
+std::string digest( const std::string& text )
+{
+    const checksum256 hash = sha256( reinterpret_cast<const uint8_t*>( text.data() ), text.size() );
+    return to_hex( hash.data(), hash.size() );
+}
+
+voter_row voter( const std::string& owner, const std::string& next_claim_period, int64_t staked )
+{
+    voter_row row;
+    row.owner = string_to_name( owner );
+    row.next_claim_period = string_to_time_point_sec( next_claim_period );
+    row.staked = staked;
+    return row;
+}
+
+} // namespace
+
+TEST_CASE( "sha256 matches FIPS 180-4 vectors" ) {
+    CHECK( digest( "" ) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" );
+    CHECK( digest( "abc" ) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" );
+    CHECK( digest( "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq" ) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" );
+    CHECK( digest( std::string( 1000, 'a' ) ) == "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3" );
+}
+
+TEST_CASE( "leaf hashes the packed index, owner & amounts" ) {
+    const asset dapp = string_to_asset( "50.6800 DAPP" ), eos = string_to_asset( "0.5068 EOS" );
+    uint8_t data[49];
+    const uint64_t index = 195, owner = string_to_name( "myaccount" );
+    std::memcpy( data, &index, 8 );
+    std::memcpy( data + 8, &owner, 8 );
+    data[16] = 2;
+    std::memcpy( data + 17, &dapp.amount, 8 );
+    std::memcpy( data + 25, &dapp.symbol, 8 );
+    std::memcpy( data + 33, &eos.amount, 8 );
+    std::memcpy( data + 41, &eos.symbol, 8 );
+    CHECK( merkle_leaf( index, owner, { dapp, eos } ) == sha256( data, sizeof( data ) ) );
+    CHECK( merkle_leaf( index, owner, { eos, dapp } ) != merkle_leaf( index, owner, { dapp, eos } ) );
+}
+
+TEST_CASE( "proofs verify for every leaf of odd & even trees" ) {
+    for ( uint64_t leaves = 1; leaves <= 17; ++leaves ) {
+        std::vector<checksum256> hashes;
+        for ( uint64_t i = 0; i < leaves; ++i ) hashes.push_back( merkle_leaf( i, 1000 + i, { asset{ 10, string_to_asset( "0.0000 EOS" ).symbol } } ) );
+        const merkle_tree tree( hashes );
+        CHECK( tree.size() == leaves );
+
+        for ( uint64_t i = 0; i < leaves; ++i ) {
+            const std::vector<checksum256> proof = tree.proof( i );
+            CHECK( proof.size() == merkle_depth( leaves ) );
+            CHECK( verify_proof( tree.root(), hashes[i], i, leaves, proof ) );
+            CHECK( !verify_proof( tree.root(), hashes[i], i ^ 1, leaves, proof ) || ( i ^ 1 ) >= leaves || hashes[i] == hashes[i ^ 1] );
+        }
+    }
+}
+
+TEST_CASE( "tampered claims are rejected" ) {
+    std::vector<checksum256> hashes;
+    const asset amount = string_to_asset( "1.0000 EOS" );
+    for ( uint64_t i = 0; i < 5; ++i ) hashes.push_back( merkle_leaf( i, 1000 + i, { amount } ) );
+    const merkle_tree tree( hashes );
+    const std::vector<checksum256> proof = tree.proof( 4 );
+
+    CHECK( verify_proof( tree.root(), hashes[4], 4, 5, proof ) );
+    CHECK( !verify_proof( tree.root(), merkle_leaf( 4, 1004, { string_to_asset( "2.0000 EOS" ) } ), 4, 5, proof ) );
+    CHECK( !verify_proof( tree.root(), merkle_leaf( 4, 1003, { amount } ), 4, 5, proof ) );
+    CHECK( !verify_proof( tree.root(), merkle_leaf( 4, 1004, { amount, string_to_asset( "1.0000 DAPP" ) } ), 4, 5, proof ) );
+    // the self-paired last node of an odd level cannot be claimed again at a phantom index
+    CHECK( !verify_proof( tree.root(), hashes[4], 5, 5, proof ) );
+    CHECK( !verify_proof( tree.root(), hashes[4], 4, 5, std::vector<checksum256>( proof.begin(), proof.end() - 1 ) ) );
+}
+
+TEST_CASE( "calculate_amount follows the README example" ) {
+    CHECK( calculate_amount( 100000000, 10000, 185, 86400, 10000 ) == 5068 );
+    CHECK( calculate_amount( 100000000, 5000, 185, 86400, 10000 ) == 2534 );
+    CHECK( calculate_amount( 100000000, 10000, 185, 86400, 0 ) == 0 );
+}
+
+TEST_CASE( "epoch pays every reward token of due voters in one leaf" ) {
+    const uint64_t EOS = string_to_symbol_code( "EOS" ), USDT = string_to_symbol_code( "USDT" );
+    std::vector<reward_row> rewards = {
+        { string_to_asset( "0.0000 USDT" ).symbol, string_to_name( "tethertether" ), string_to_asset( "0.3436 EOS" ) },
+        { string_to_asset( "0.0000 EOS" ).symbol, string_to_name( "eosio.token" ), string_to_asset( "1.0000 EOS" ) },
+        { string_to_asset( "0.0000 DAPP" ).symbol, string_to_name( "dappservices" ), string_to_asset( "0.0050 EOS" ) },
+    };
+    std::vector<voter_row> voters = {
+        voter( "zed", "2019-08-07T00:00:00", 100000000 ),
+        voter( "alice", "2019-08-07T00:00:00", 200000000 ),
+        voter( "late", "2019-08-08T00:00:00", 100000000 ),
+        voter( "bob", "2019-08-06T00:00:00", 100000000 ),
+        voter( "carol", "2019-08-06T00:00:00", 100000000 ),
+    };
+    std::unordered_map<uint64_t, portfolio_row> portfolios;
+    portfolios[string_to_name( "bob" )] = { string_to_name( "bob" ), { EOS, USDT }, { 5000, 5000 } };
+    portfolios[string_to_name( "carol" )] = { string_to_name( "carol" ), { USDT }, { 10000 } };
+
+    const epoch_result epoch = build_epoch( rewards, voters, portfolios, { string_to_time_point_sec( "2019-08-07T00:00:00" ), 185, 86400 } );
+    CHECK( epoch.leaves.size() == 4 );
+    CHECK( epoch.leaves[0].owner == string_to_name( "alice" ) );
+    CHECK( epoch.leaves[0].amounts.size() == 1 && epoch.leaves[0].amounts[0].amount == 10136 );
+
+    // bob's portfolio is a single leaf with both tokens, in the order of the totals
+    CHECK( epoch.leaves[1].owner == string_to_name( "bob" ) );
+    CHECK( epoch.leaves[1].amounts.size() == 2 );
+    CHECK( asset_to_string( epoch.leaves[1].amounts[0] ) == "0.2534 EOS" );
+    CHECK( epoch.leaves[1].amounts[1].symbol == string_to_asset( "0.0000 USDT" ).symbol );
+    CHECK( epoch.leaves[1].amounts[1].amount == calculate_amount( 100000000, 5000, 185, 86400, 3436 ) );
+    CHECK( epoch.leaves[2].owner == string_to_name( "carol" ) );
+    CHECK( epoch.leaves[3].owner == string_to_name( "zed" ) );
+
+    // DAPP is registered but nobody holds it, totals are sorted by symbol code
+    CHECK( epoch.totals.size() == 2 );
+    CHECK( asset_to_string( epoch.totals[0] ) == "1.7738 EOS" );
+    CHECK( epoch.contracts[0] == string_to_name( "eosio.token" ) );
+    CHECK( epoch.totals[1].amount == epoch.leaves[1].amounts[1].amount + epoch.leaves[2].amounts[0].amount );
+    CHECK( epoch.contracts[1] == string_to_name( "tethertether" ) );
+
+    const merkle_tree tree = build_tree( epoch.leaves );
+    CHECK( tree.root() == epoch.root );
+    CHECK( verify_proof( epoch.root, merkle_leaf( 1, epoch.leaves[1].owner, epoch.leaves[1].amounts ), 1, 4, tree.proof( 1 ) ) );
+    CHECK( !verify_proof( epoch.root, merkle_leaf( 1, epoch.leaves[1].owner, { epoch.leaves[1].amounts[0] } ), 1, 4, tree.proof( 1 ) ) );
+}
+
+TEST_CASE( "leaves file round-trips" ) {
+    const std::string path = "/tmp/merkle_test_leaves.jsonl";
+    const std::vector<epoch_leaf> leaves = {
+        { string_to_name( "alice" ), { string_to_asset( "1.0136 EOS" ) } },
+        { string_to_name( "bob" ), { string_to_asset( "0.2534 EOS" ), string_to_asset( "0.7375 USDT" ) } },
+    };
+    write_leaves( path, leaves );
+    const std::vector<epoch_leaf> read = read_leaves( path );
+    CHECK( read.size() == 2 );
+    CHECK( read[1].owner == leaves[1].owner );
+    CHECK( read[1].amounts.size() == 2 );
+    CHECK( read[1].amounts[1].amount == leaves[1].amounts[1].amount );
+    CHECK( build_tree( read ).root() == build_tree( leaves ).root() );
+    std::remove( path.c_str() );
+}
+
+TEST_MAIN()
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace proxy_tools::test {
+
+/**
+ * Local HTTP server standing in for nodeos/keosd in tests
+ *
+ * `handler( path, body )` returns `{ status, body }`; requests are served one at a time on 127.0.0.1.
+ */
+class mock_rpc_server {
+public:
+    using handler_type = std::function<std::pair<int, std::string>( const std::string&, const std::string& )>;
+
+    explicit mock_rpc_server( handler_type handler ) : _handler( std::move( handler ) )
+    {
+        _fd = ::socket( AF_INET, SOCK_STREAM, 0 );
+        const int yes = 1;
+        ::setsockopt( _fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof( yes ) );
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        addr.sin_port = 0;
+        ::bind( _fd, reinterpret_cast<sockaddr*>( &addr ), sizeof( addr ) );
+        ::listen( _fd, 64 );
+        socklen_t len = sizeof( addr );
+        ::getsockname( _fd, reinterpret_cast<sockaddr*>( &addr ), &len );
+        _port = ntohs( addr.sin_port );
+        _thread = std::thread( [this] { serve(); } );
+    }
+
+    ~mock_rpc_server()
+    {
+        _stop = true;
+        ::shutdown( _fd, SHUT_RDWR );
+        ::close( _fd );
+        _thread.join();
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string( _port ); }
+
+private:
+    handler_type        _handler;
+    int                 _fd = -1;
+    int                 _port = 0;
+    std::atomic<bool>   _stop{ false };
+    std::thread         _thread;
+
+    void serve()
+    {
+        while ( !_stop ) {
+            const int client = ::accept( _fd, nullptr, nullptr );
+            if ( client < 0 ) continue;
+            handle( client );
+            ::close( client );
+        }
+    }
+
+    void handle( int client )
+    {
+        std::string raw;
+        char buffer[8192];
+        size_t header_end = std::string::npos;
+        size_t content_length = 0;
+        while ( true ) {
+            const ssize_t n = ::recv( client, buffer, sizeof( buffer ), 0 );
+            if ( n <= 0 ) return;
+            raw.append( buffer, n );
+            if ( header_end == std::string::npos && ( header_end = raw.find( "\r\n\r\n" ) ) != std::string::npos ) {
+                const size_t pos = raw.find( "Content-Length: " );
+                if ( pos != std::string::npos && pos < header_end ) content_length = std::stoul( raw.substr( pos + 16 ) );
+            }
+            if ( header_end != std::string::npos && raw.size() >= header_end + 4 + content_length ) break;
+        }
+
+        const size_t path_start = raw.find( ' ' ) + 1;
+        const std::string path = raw.substr( path_start, raw.find( ' ', path_start ) - path_start );
+        const auto [status, body] = _handler( path, raw.substr( header_end + 4, content_length ) );
+
+        const std::string response =
+            "HTTP/1.1 " + std::to_string( status ) + " OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: " + std::to_string( body.size() ) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+        ::send( client, response.data(), response.size(), MSG_NOSIGNAL );
+    }
+};
+
+} // namespace proxy_tools::test
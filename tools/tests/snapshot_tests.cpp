@@ -0,0 +1,125 @@
+#include "test.hpp"
+
+#include "../snapshot/export.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace proxy_tools;
+
+namespace {
+
+std::string pack_voter_hex( const std::string& owner, uint32_t next_claim, int64_t staked, const std::string& referral )
+{
+    packer p;
+    p.u64( string_to_name( owner ) );
+    p.u32( next_claim );
+    p.i64( staked );
+    p.u64( string_to_name( referral ) );
+    p.varuint32( 2 );
+    p.u64( string_to_symbol_code( "DAPP" ) );
+    p.u64( string_to_symbol_code( "EOS" ) );
+    p.varuint32( 1 );
+    p.u64( string_to_name( "staked" ) );
+    p.u8( 1 );
+    return to_hex( p.data().data(), p.data().size() );
+}
+
+void write_file( const std::string& path, const std::string& content )
+{
+    std::ofstream( path ) << content;
+}
+
+} // namespace
+
+TEST_CASE( "binary voters.v2 row decodes like the contract struct" ) {
+    const voter_row row = parse_voter( json( pack_voter_hex( "myaccount", 1565203057, 20049272, "tokenyieldio" ) ) );
+    CHECK( row.owner == string_to_name( "myaccount" ) );
+    CHECK( row.next_claim_period == 1565203057 );
+    CHECK( row.staked == 20049272 );
+    CHECK( row.referral == string_to_name( "tokenyieldio" ) );
+    CHECK( row.rewards.size() == 2 );
+    CHECK( row.protocol_features.size() == 1 && row.protocol_features[0].second );
+}
+
+TEST_CASE( "json rows decode" ) {
+    const voter_row voter = parse_voter( json::parse( R"({"owner":"myaccount","next_claim_period":"2019-08-07T18:37:37","staked":6000,"referral":"","rewards":["EOS"],"protocol_features":[]})" ) );
+    CHECK( voter.staked == 6000 );
+    CHECK( voter.referral == 0 );
+    CHECK( voter.rewards.size() == 1 );
+
+    const reward_row reward = parse_reward( json::parse( R"({"symbol":"4,DAPP","contract":"dappservices","price":"0.0050 EOS"})" ) );
+    CHECK( reward.symbol == ( ( string_to_symbol_code( "DAPP" ) << 8 ) | 4 ) );
+    CHECK( reward.price.amount == 50 );
+}
+
+TEST_CASE( "export writes a queryable columnar snapshot" ) {
+    const export_paths paths{ "/tmp/snapshot_test_rewards.json", "/tmp/snapshot_test_voters.json", "/tmp/snapshot_test_portfolio.jsonl", "/tmp/snapshot_test.pxsnap" };
+    write_file( paths.rewards, "{\n  \"rows\": [\n    {\"symbol\":\"4,EOS\",\"contract\":\"eosio.token\",\"price\":\"1.0000 EOS\"},\n    {\"symbol\":\"4,DAPP\",\"contract\":\"dappservices\",\"price\":\"0.0050 EOS\"},\n    {\"symbol\":\"4,USDT\",\"contract\":\"tethertether\",\"price\":\"0.3436 EOS\"}\n  ],\n  \"more\": false\n}\n" );
+    write_file( paths.voters,
+        R"({"rows":[{"owner":"zed","next_claim_period":"2019-08-07T00:00:00","staked":300,"referral":"tokenyieldio","rewards":["EOS"],"protocol_features":[]},)"
+        R"({"owner":"alice","next_claim_period":"2019-08-09T00:00:00","staked":100,"referral":"","rewards":["EOS"],"protocol_features":[]}],"more":true})" "\n"
+        R"({"rows":[")" + pack_voter_hex( "bob", string_to_time_point_sec( "2019-08-06T00:00:00" ), 200, "tokenyieldio" ) + R"("],"more":false})" "\n" );
+    write_file( paths.portfolio,
+        R"({"owner":"bob","rewards":["EOS","USDT"],"percentages":[9000,1000]})" "\n"
+        R"({"owner":"gone","rewards":["EOS"],"percentages":[10000]})" "\n" );
+
+    const export_stats stats = export_snapshot( paths );
+    CHECK( stats.voters == 3 );
+    CHECK( stats.portfolios == 1 );
+    CHECK( stats.entries == 2 );
+    CHECK( stats.bytes % 8 == 0 );
+
+    {
+        snapshot_view view( paths.output );
+        CHECK( view.size() == 3 );
+        CHECK( view.header().reward_count == 3 );
+        CHECK( view.owner()[0] == string_to_name( "alice" ) );
+        CHECK( view.find( string_to_name( "zed" ) ) == 2 );
+        CHECK( view.find( string_to_name( "gone" ) ) == -1 );
+        CHECK( view.total_staked() == 600 );
+        CHECK( view.count_due( string_to_time_point_sec( "2019-08-08T00:00:00" ) ) == 2 );
+        CHECK( view.staked_by_referral( string_to_name( "tokenyieldio" ) ) == 500 );
+        CHECK( view.count_reward_holders( string_to_symbol_code( "DAPP" ) ) == 1 );
+        CHECK( view.count_reward_holders( string_to_symbol_code( "EOS" ) ) == 3 );
+
+        const int64_t bob = view.find( string_to_name( "bob" ) );
+        CHECK( view.portfolio_index()[bob + 1] - view.portfolio_index()[bob] == 2 );
+        const uint32_t first = view.portfolio_index()[bob];
+        CHECK( view.portfolio_reward()[first + 1] == 2 );
+        CHECK( view.portfolio_percentage()[first + 1] == 1000 );
+        CHECK( view.portfolio_index()[0] == view.portfolio_index()[1] );
+    }
+
+    for ( const std::string& path : { paths.rewards, paths.voters, paths.portfolio, paths.output } ) std::remove( path.c_str() );
+}
+
+TEST_CASE( "export skips and counts rewards missing from the rewards dump" ) {
+    const export_paths paths{ "/tmp/snapshot_unknown_rewards.json", "/tmp/snapshot_unknown_voters.json", "/tmp/snapshot_unknown_portfolio.jsonl", "/tmp/snapshot_unknown.pxsnap" };
+    write_file( paths.rewards, R"({"rows":[{"symbol":"4,EOS","contract":"eosio.token","price":"1.0000 EOS"}],"more":false})" "\n" );
+    write_file( paths.voters,
+        R"({"rows":[{"owner":"alice","next_claim_period":"2019-08-07T00:00:00","staked":100,"referral":"","rewards":["EOS","KARMA"],"protocol_features":[]},)"
+        R"({"owner":"bob","next_claim_period":"2019-08-07T00:00:00","staked":200,"referral":"","rewards":["EOS"],"protocol_features":[]}],"more":false})" "\n" );
+    write_file( paths.portfolio, R"({"owner":"bob","rewards":["KARMA","EOS"],"percentages":[5000,5000]})" "\n" );
+
+    const export_stats stats = export_snapshot( paths );
+    CHECK( stats.voters == 2 );
+    CHECK( stats.unknown_rewards == 2 );
+    CHECK( stats.entries == 1 );
+
+    {
+        snapshot_view view( paths.output );
+        CHECK( view.header().reward_count == 1 );
+        CHECK( view.reward_mask()[0] == 1 );
+        CHECK( view.count_reward_holders( string_to_symbol_code( "EOS" ) ) == 2 );
+
+        const uint32_t first = view.portfolio_index()[1];
+        CHECK( view.portfolio_index()[2] - first == 1 );
+        CHECK( view.portfolio_reward()[first] == 0 );
+        CHECK( view.portfolio_percentage()[first] == 5000 );
+    }
+
+    for ( const std::string& path : { paths.rewards, paths.voters, paths.portfolio, paths.output } ) std::remove( path.c_str() );
+}
+
+TEST_MAIN()
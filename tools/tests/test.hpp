@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimal test harness for the host tools (no external test framework)
+namespace proxy_tools::test {
+
+struct test_case {
+    const char*             name;
+    std::function<void()>   body;
+};
+
+inline std::vector<test_case>& registry()
+{
+    static std::vector<test_case> tests;
+    return tests;
+}
+
+struct registrar {
+    registrar( const char* name, std::function<void()> body ) { registry().push_back( { name, std::move( body ) } ); }
+};
+
+struct failure {
+    std::string what;
+};
+
+inline int run_all()
+{
+    int failed = 0;
+    for ( const test_case& test : registry() ) {
+        try {
+            test.body();
+            std::cout << "[ OK ] " << test.name << std::endl;
+        } catch ( const failure& f ) {
+            ++failed;
+            std::cout << "[FAIL] " << test.name << ": " << f.what << std::endl;
+        } catch ( const std::exception& e ) {
+            ++failed;
+            std::cout << "[FAIL] " << test.name << ": exception " << e.what() << std::endl;
+        }
+    }
+    return failed ? 1 : 0;
+}
+
+} // namespace proxy_tools::test
+
+#define PROXY_TEST_CONCAT_( a, b ) a##b
+#define PROXY_TEST_CONCAT( a, b ) PROXY_TEST_CONCAT_( a, b )
+
+#define TEST_CASE( name ) \
+    static void PROXY_TEST_CONCAT( test_fn_, __LINE__ )(); \
+    static proxy_tools::test::registrar PROXY_TEST_CONCAT( test_reg_, __LINE__ )( name, PROXY_TEST_CONCAT( test_fn_, __LINE__ ) ); \
+    static void PROXY_TEST_CONCAT( test_fn_, __LINE__ )()
+
+#define CHECK( expr ) \
+    do { if ( !( expr ) ) throw proxy_tools::test::failure{ std::string( __FILE__ ) + ":" + std::to_string( __LINE__ ) + ": CHECK(" #expr ")" }; } while ( 0 )
+
+#define TEST_MAIN() int main() { return proxy_tools::test::run_all(); }